@@ -2,13 +2,105 @@
 
 #include "starobservationschedulingsolver/flexible_single_night_star_observation_scheduling/solution.hpp"
 
+#include <sstream>
+
 namespace starobservationschedulingsolver
 {
 namespace flexible_single_night_star_observation_scheduling
 {
 
+/**
+ * Engine of the dynamic programming algorithm.
+ *
+ * - 'Pareto': the states of a stage are the Pareto front of the (end time,
+ *   profit) pairs of the schedules of the previous targets. The observation
+ *   time intervals are expanded into one observation time per time unit.
+ *   It is the only engine which can be approximate, see
+ *   'DynamicProgrammingOptionalParameters::epsilon'.
+ * - 'TimeIndexed': a stage is a dense array of the best profit of the
+ *   schedules for which the telescope is free at each time unit of the
+ *   night. Its complexity is O(n K T) where K is the number of observation
+ *   times and observation time intervals per target and T is the length of
+ *   the night: an interval costs as much as a single observation time,
+ *   whatever its length. It supports at most 253 observation times and
+ *   observation time intervals per target.
+ * - 'Auto': the engine is selected with
+ *   'select_dynamic_programming_engine'.
+ */
+enum class DynamicProgrammingEngine
+{
+    Auto,
+    Pareto,
+    TimeIndexed,
+};
+
+std::istream& operator>>(
+        std::istream& in,
+        DynamicProgrammingEngine& engine);
+
+std::ostream& operator<<(
+        std::ostream& os,
+        DynamicProgrammingEngine engine);
+
+/**
+ * Select the engine of the dynamic programming algorithm.
+ *
+ * As for the single-night problem, the time-indexed engine is selected when
+ * the night is at most 10 times longer than the number of targets, where
+ * each observation time of an interval counts as an additional target since
+ * the Pareto engine expands them.
+ */
+DynamicProgrammingEngine select_dynamic_programming_engine(
+        const Instance& instance);
+
 struct DynamicProgrammingOptionalParameters: Parameters
 {
+    /** Engine. */
+    DynamicProgrammingEngine engine = DynamicProgrammingEngine::Auto;
+
+    /**
+     * Relative accuracy of the Pareto engine.
+     *
+     * If positive, the states of the Pareto fronts whose profit is close to
+     * the profit of an earlier state are removed, and the profit of the
+     * returned solution is at least '1 - epsilon' times the optimal profit.
+     */
+    double epsilon = 0;
+
+    /**
+     * Maximum number of states of the Pareto engine.
+     *
+     * The accuracy is decreased as needed to respect it. The bound of the
+     * output is the profit of the solution divided by the resulting
+     * guarantee.
+     */
+    Counter maximum_number_of_states = std::numeric_limits<Counter>::max();
+
+
+    virtual nlohmann::json to_json() const override
+    {
+        std::stringstream engine_ss;
+        engine_ss << engine;
+        nlohmann::json json = Parameters::to_json();
+        json.merge_patch({
+                {"Engine", engine_ss.str()},
+                {"Epsilon", epsilon},
+                {"MaximumNumberOfStates", maximum_number_of_states}});
+        return json;
+    }
+
+    virtual int format_width() const override { return 28; }
+
+    virtual void format(std::ostream& os) const override
+    {
+        Parameters::format(os);
+        int width = format_width();
+        os
+            << std::setw(width) << std::left << "Engine: " << engine << std::endl
+            << std::setw(width) << std::left << "Epsilon: " << epsilon << std::endl
+            << std::setw(width) << std::left << "Maximum number of states: " << maximum_number_of_states << std::endl
+            ;
+    }
 };
 
 const Output dynamic_programming(
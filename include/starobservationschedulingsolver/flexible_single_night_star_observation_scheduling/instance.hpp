@@ -1,5 +1,8 @@
 #pragma once
 
+#include "starobservationschedulingsolver/utils/types.hpp"
+#include "starobservationschedulingsolver/utils/span.hpp"
+
 #include <cstdint>
 #include <vector>
 #include <iostream>
@@ -9,12 +12,41 @@ namespace starobservationschedulingsolver
 namespace flexible_single_night_star_observation_scheduling
 {
 
-using TargetId = int64_t;
+using TargetId = IdType;
 using Profit = double;
-using Time = int64_t;
+using Time = TimeType;
 using Counter = int64_t;
 using Seed = int64_t;
 
+/**
+ * Structure for an interval of observation times.
+ *
+ * Any observation time between 'minimum_observation_time' and
+ * 'maximum_observation_time' can be used. Observing during observation time
+ * 'p' yields a profit of
+ * 'profit + profit_slope * (p - minimum_observation_time)'.
+ */
+struct ObservationTimeInterval
+{
+    /** Minimum observation time. */
+    Time minimum_observation_time;
+
+    /** Maximum observation time. */
+    Time maximum_observation_time;
+
+    /** Profit of the minimum observation time. */
+    Profit profit;
+
+    /** Profit of each additional time unit of observation. */
+    Profit profit_slope;
+
+    /** Get the profit of an observation time of the interval. */
+    Profit observation_time_profit(Time observation_time) const
+    {
+        return profit + profit_slope * (observation_time - minimum_observation_time);
+    }
+};
+
 /**
  * Structure for a target.
  */
@@ -29,11 +61,28 @@ struct Target
     /** Deadline. */
     Time deadline;
 
-    /** Observation times. */
-    std::vector<Time> observation_times;
+    /**
+     * Position of the first observation time of the target in the
+     * observation time arrays of the instance.
+     */
+    Counter observation_times_start = 0;
+
+    /** Number of observation times. */
+    Counter number_of_observation_times = 0;
+
+    /**
+     * Position of the first observation time interval of the target in the
+     * observation time interval array of the instance.
+     */
+    Counter observation_time_intervals_start = 0;
 
-    /** Profits. */
-    std::vector<Profit> profits;
+    /**
+     * Number of observation time intervals.
+     *
+     * In a solution, the observation time position of the interval at
+     * position 'pos' is 'number_of_observation_times + pos'.
+     */
+    Counter number_of_observation_time_intervals = 0;
 
     /** Maximum profit. */
     Profit maximum_profit = 0;
@@ -57,9 +106,36 @@ public:
     /** Get a target. */
     const Target& target(TargetId target_id) const { return targets_[target_id]; }
 
+    /** Get the observation times of a target. */
+    Span<Time> observation_times(TargetId target_id) const
+    {
+        const Target& target = targets_[target_id];
+        return {observation_times_.data() + target.observation_times_start, target.number_of_observation_times};
+    }
+
+    /** Get the profits of the observation times of a target. */
+    Span<Profit> profits(TargetId target_id) const
+    {
+        const Target& target = targets_[target_id];
+        return {profits_.data() + target.observation_times_start, target.number_of_observation_times};
+    }
+
+    /** Get the observation time intervals of a target. */
+    Span<ObservationTimeInterval> observation_time_intervals(TargetId target_id) const
+    {
+        const Target& target = targets_[target_id];
+        return {observation_time_intervals_.data() + target.observation_time_intervals_start, target.number_of_observation_time_intervals};
+    }
+
     /** Get the total profit of the targets. */
     Profit total_profit() const { return total_profit_; }
 
+    /**
+     * Get the number of observation times removed by the reduction applied
+     * when building the instance.
+     */
+    Counter number_of_removed_observation_times() const { return number_of_removed_observation_times_; }
+
     /*
      * Export
      */
@@ -85,9 +161,21 @@ private:
     /** Targets. */
     std::vector<Target> targets_;
 
+    /** Observation times of all targets, stored target by target. */
+    std::vector<Time> observation_times_;
+
+    /** Profits of the observation times of all targets. */
+    std::vector<Profit> profits_;
+
+    /** Observation time intervals of all targets, stored target by target. */
+    std::vector<ObservationTimeInterval> observation_time_intervals_;
+
     /** Total profit. */
     Profit total_profit_ = 0;
 
+    /** Number of removed observation times. */
+    Counter number_of_removed_observation_times_ = 0;
+
     friend class InstanceBuilder;
 
 };
@@ -2,6 +2,8 @@
 
 #include "starobservationschedulingsolver/flexible_single_night_star_observation_scheduling/instance.hpp"
 
+#include "starobservationschedulingsolver/utils/observation_times.hpp"
+
 namespace starobservationschedulingsolver
 {
 namespace flexible_single_night_star_observation_scheduling
@@ -27,6 +29,23 @@ public:
             Time observation_time,
             Profit profit);
 
+    /** Add an interval of observation times for a target. */
+    void add_observation_time_interval(
+            TargetId target_id,
+            Time minimum_observation_time,
+            Time maximum_observation_time,
+            Profit profit,
+            Profit profit_slope);
+
+    /**
+     * Set the reduction of the observation times applied when building the
+     * instance.
+     *
+     * The positions of the observation times of the built instance are the
+     * positions after the reduction.
+     */
+    void set_observation_time_reduction(ObservationTimeReduction observation_time_reduction) { observation_time_reduction_ = observation_time_reduction; }
+
     /** Read an instance from a file. */
     void read(
             const std::string& instance_path,
@@ -59,6 +78,29 @@ private:
     /** Instance. */
     Instance instance_;
 
+    /*
+     * The observation times and the observation time intervals are stored
+     * in the order in which they are added; 'build' groups them by target.
+     */
+
+    /** Targets of the added observation times. */
+    std::vector<TargetId> observation_time_targets_;
+
+    /** Added observation times. */
+    std::vector<Time> observation_times_;
+
+    /** Profits of the added observation times. */
+    std::vector<Profit> profits_;
+
+    /** Targets of the added observation time intervals. */
+    std::vector<TargetId> observation_time_interval_targets_;
+
+    /** Added observation time intervals. */
+    std::vector<ObservationTimeInterval> observation_time_intervals_;
+
+    /** Reduction of the observation times. */
+    ObservationTimeReduction observation_time_reduction_ = ObservationTimeReduction::None;
+
 };
 
 }
@@ -26,6 +26,12 @@ struct Observation
     /** Observation time. */
     Counter observation_time_pos;
 
+    /** Length of the observation. */
+    Time observation_time;
+
+    /** Profit of the observation. */
+    Profit profit;
+
     /** Start time. */
     Time start_time;
 };
@@ -45,10 +51,28 @@ public:
     /** Constructor. */
     Solution(const Instance& instance);
 
-    /** Add an observation. */
+    /**
+     * Add an observation with a discrete observation time.
+     *
+     * 'observation_time_pos' must be the position of a discrete observation
+     * time; the observation time of an interval must be given explicitly.
+     */
+    void append_observation(
+            TargetId target_id,
+            Counter observation_time_pos,
+            Time start_time);
+
+    /**
+     * Add an observation.
+     *
+     * 'observation_time' must be the observation time of the discrete
+     * observation time at 'observation_time_pos', or belong to the
+     * observation time interval at this position.
+     */
     void append_observation(
             TargetId target_id,
             Counter observation_time_pos,
+            Time observation_time,
             Time start_time);
 
     /*
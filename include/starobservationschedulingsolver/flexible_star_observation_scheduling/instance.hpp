@@ -1,5 +1,8 @@
 #pragma once
 
+#include "starobservationschedulingsolver/utils/types.hpp"
+#include "starobservationschedulingsolver/utils/span.hpp"
+
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -9,15 +12,44 @@ namespace starobservationschedulingsolver
 namespace flexible_star_observation_scheduling
 {
 
-using NightId = int64_t;
-using TargetId = int64_t;
-using ObservableId = int64_t;
-using ObservablePos = int64_t;
+using NightId = IdType;
+using TargetId = IdType;
+using ObservableId = IdType;
+using ObservablePos = IdType;
 using Profit = double;
-using Time = int64_t;
+using Time = TimeType;
 using Counter = int64_t;
 using Seed = int64_t;
 
+/**
+ * Structure for an interval of observation times.
+ *
+ * Any observation time between 'minimum_observation_time' and
+ * 'maximum_observation_time' can be used. Observing during observation time
+ * 'p' yields a profit of
+ * 'profit + profit_slope * (p - minimum_observation_time)'.
+ */
+struct ObservationTimeInterval
+{
+    /** Minimum observation time. */
+    Time minimum_observation_time;
+
+    /** Maximum observation time. */
+    Time maximum_observation_time;
+
+    /** Profit of the minimum observation time. */
+    Profit profit;
+
+    /** Profit of each additional time unit of observation. */
+    Profit profit_slope;
+
+    /** Get the profit of an observation time of the interval. */
+    Profit observation_time_profit(Time observation_time) const
+    {
+        return profit + profit_slope * (observation_time - minimum_observation_time);
+    }
+};
+
 /**
  * Structure for an observable.
  */
@@ -35,11 +67,28 @@ struct Observable
     /** Deadline of the observable. */
     Time deadline;
 
-    /** Observation times of the observable. */
-    std::vector<Time> observation_times;
+    /**
+     * Position of the first observation time of the observable in the
+     * observation time arrays of the instance.
+     */
+    Counter observation_times_start = 0;
+
+    /** Number of observation times of the observable. */
+    Counter number_of_observation_times = 0;
 
-    /** Profits of the observation. */
-    std::vector<Profit> profits;
+    /**
+     * Position of the first observation time interval of the observable in
+     * the observation time interval array of the instance.
+     */
+    Counter observation_time_intervals_start = 0;
+
+    /**
+     * Number of observation time intervals of the observable.
+     *
+     * In a solution, the observation time position of the interval at
+     * position 'pos' is 'number_of_observation_times + pos'.
+     */
+    Counter number_of_observation_time_intervals = 0;
 
     /** Maximum profit. */
     Profit maximum_profit = 0;
@@ -77,9 +126,77 @@ public:
         return observables_[night_id][observable_id];
     }
 
+    /** Get the observation times of an observable. */
+    Span<Time> observation_times(
+            NightId night_id,
+            ObservableId observable_id) const
+    {
+        const Observable& observable = observables_[night_id][observable_id];
+        return {observation_times_.data() + observable.observation_times_start, observable.number_of_observation_times};
+    }
+
+    /** Get the profits of the observation times of an observable. */
+    Span<Profit> profits(
+            NightId night_id,
+            ObservableId observable_id) const
+    {
+        const Observable& observable = observables_[night_id][observable_id];
+        return {profits_.data() + observable.observation_times_start, observable.number_of_observation_times};
+    }
+
+    /** Get the observation time intervals of an observable. */
+    Span<ObservationTimeInterval> observation_time_intervals(
+            NightId night_id,
+            ObservableId observable_id) const
+    {
+        const Observable& observable = observables_[night_id][observable_id];
+        return {observation_time_intervals_.data() + observable.observation_time_intervals_start, observable.number_of_observation_time_intervals};
+    }
+
     /** Get the total profit of the targets. */
     Profit total_profit() const { return profit_sum_; }
 
+    /**
+     * Get the number of observation times removed by the reduction applied
+     * when building the instance.
+     */
+    Counter number_of_removed_observation_times() const { return number_of_removed_observation_times_; }
+
+    /*
+     * Reduction
+     */
+
+    /** Return 'true' iff the instance has been reduced when it was built. */
+    bool reduced() const { return reduced_; }
+
+    /** Get the original id of a target. */
+    TargetId original_target_id(TargetId target_id) const
+    {
+        return (reduced_)? original_target_ids_[target_id]: target_id;
+    }
+
+    /** Get the original id of an observable. */
+    ObservableId original_observable_id(
+            NightId night_id,
+            ObservableId observable_id) const
+    {
+        return (reduced_)?
+            original_observable_ids_[night_id][observable_id]:
+            observable_id;
+    }
+
+    /**
+     * Get the number of observables removed by the reduction because their
+     * shortest observation time doesn't fit in their time window.
+     */
+    Counter number_of_infeasible_observables() const { return number_of_infeasible_observables_; }
+
+    /**
+     * Get the number of targets removed by the reduction because their
+     * observables have no positive profit.
+     */
+    TargetId number_of_unprofitable_targets() const { return number_of_unprofitable_targets_; }
+
     /*
      * Export
      */
@@ -97,7 +214,13 @@ public:
      * Checkers
      */
 
-    /** Check a certificate. */
+    /**
+     * Check a certificate.
+     *
+     * Each observation is given by its observable and its observation time
+     * position. For the position of an observation time interval, it is
+     * followed by the observation time.
+     */
     std::pair<bool, Profit> check(
             const std::string& certificate_path,
             std::ostream& os,
@@ -122,6 +245,21 @@ private:
     /** Observables. */
     std::vector<std::vector<Observable>> observables_;
 
+    /**
+     * Observation times of all observables, stored observable by observable
+     * and night by night.
+     */
+    std::vector<Time> observation_times_;
+
+    /** Profits of the observation times of all observables. */
+    std::vector<Profit> profits_;
+
+    /**
+     * Observation time intervals of all observables, stored observable by
+     * observable and night by night.
+     */
+    std::vector<ObservationTimeInterval> observation_time_intervals_;
+
     /** Number of observables. */
     ObservableId number_of_observables_ = 0;
 
@@ -132,6 +270,24 @@ private:
     /** Sum of the profits of the targets. */
     Profit profit_sum_ = 0;
 
+    /** Number of removed observation times. */
+    Counter number_of_removed_observation_times_ = 0;
+
+    /** 'true' iff the instance has been reduced. */
+    bool reduced_ = false;
+
+    /** Original id of each target if the instance is reduced. */
+    std::vector<TargetId> original_target_ids_;
+
+    /** Original id of each observable if the instance is reduced. */
+    std::vector<std::vector<ObservableId>> original_observable_ids_;
+
+    /** Number of infeasible observables. */
+    Counter number_of_infeasible_observables_ = 0;
+
+    /** Number of unprofitable targets. */
+    TargetId number_of_unprofitable_targets_ = 0;
+
     friend class InstanceBuilder;
 
 };
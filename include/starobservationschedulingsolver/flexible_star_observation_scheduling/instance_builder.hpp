@@ -2,6 +2,8 @@
 
 #include "starobservationschedulingsolver/flexible_star_observation_scheduling/instance.hpp"
 
+#include "starobservationschedulingsolver/utils/observation_times.hpp"
+
 namespace starobservationschedulingsolver
 {
 namespace flexible_star_observation_scheduling
@@ -36,6 +38,43 @@ public:
             Time observation_time,
             Profit profit);
 
+    /** Add an interval of observation times for an observable. */
+    void add_observation_time_interval(
+            NightId night_id,
+            ObservableId observable_id,
+            Time minimum_observation_time,
+            Time maximum_observation_time,
+            Profit profit,
+            Profit profit_slope);
+
+    /**
+     * Set the reduction of the observation times applied when building the
+     * instance.
+     *
+     * The positions of the observation times of the built instance are the
+     * positions after the reduction.
+     */
+    void set_observation_time_reduction(ObservationTimeReduction observation_time_reduction) { observation_time_reduction_ = observation_time_reduction; }
+
+    /**
+     * Enable the reduction of the instance applied when building it.
+     *
+     * The reduction removes the observables whose shortest observation time
+     * doesn't fit in their time window and the targets whose observables
+     * have no positive profit. Targets without remaining observable are
+     * removed.
+     *
+     * Unlike in the star observation scheduling problem, no target is fixed:
+     * the profit of an observation depends on its observable and on its
+     * observation time, so observing a target during a free time window may
+     * prevent a more profitable observation of it during another night.
+     *
+     * The reduction is exact. The ids of the targets and of the observables
+     * of the built instance are the ids after the reduction; solutions are
+     * written with the original ids.
+     */
+    void set_reduction(bool reduction) { reduction_ = reduction; }
+
     /** Read an instance from a file. */
     void read(
             const std::string& instance_path,
@@ -61,6 +100,9 @@ private:
     /** Read an instance file in 'catusse2016' format. */
     void read_catusse2016(std::ifstream& file);
 
+    /** Reduce the instance. */
+    void reduce();
+
     /*
      * Private attributes
      */
@@ -68,6 +110,33 @@ private:
     /** Instance. */
     Instance instance_;
 
+    /*
+     * The observation times and the observation time intervals are stored
+     * in the order in which they are added; 'build' groups them by
+     * observable.
+     */
+
+    /** Observables of the added observation times. */
+    std::vector<std::pair<NightId, ObservableId>> observation_time_observables_;
+
+    /** Added observation times. */
+    std::vector<Time> observation_times_;
+
+    /** Profits of the added observation times. */
+    std::vector<Profit> profits_;
+
+    /** Observables of the added observation time intervals. */
+    std::vector<std::pair<NightId, ObservableId>> observation_time_interval_observables_;
+
+    /** Added observation time intervals. */
+    std::vector<ObservationTimeInterval> observation_time_intervals_;
+
+    /** Reduction of the observation times. */
+    ObservationTimeReduction observation_time_reduction_ = ObservationTimeReduction::None;
+
+    /** 'true' iff the instance is reduced when it is built. */
+    bool reduction_ = false;
+
 };
 
 }
@@ -13,19 +13,975 @@
 
 #include "starobservationschedulingsolver/single_night_star_observation_scheduling/solution.hpp"
 
+#include "starobservationschedulingsolver/utils/pareto_stage.hpp"
+#include "starobservationschedulingsolver/utils/time_indexed.hpp"
+#include "starobservationschedulingsolver/utils/count_indexed.hpp"
+
+#include <sstream>
+
 namespace starobservationschedulingsolver
 {
 namespace single_night_star_observation_scheduling
 {
 
+/**
+ * Engine of the dynamic programming algorithm.
+ *
+ * - 'Pareto': the states of a stage are the Pareto front of the (end time,
+ *   profit) pairs of the schedules of the previous targets. Its complexity
+ *   depends on the size of the fronts.
+ * - 'TimeIndexed': a stage is a dense array of the best profit of the
+ *   schedules for which the telescope is free at each time unit of the
+ *   night. Its complexity is O(n T) where T is the length of the night.
+ * - 'Unicost': all the targets of positive profit must have the same profit.
+ *   Then the objective is to maximize the number of observations, and a
+ *   stage is the array of the earliest end time of the schedules of each
+ *   number of observations. Its complexity is O(n k) where k is the number
+ *   of observations of the best schedule.
+ * - 'IntervalScheduling': all the targets of positive profit must have a
+ *   rigid time window: the telescope is free from time 0, and the time
+ *   between 'max(0, release_date)' and 'deadline' must be at most the
+ *   observation time. Then each target can only be observed during a fixed
+ *   interval, and the problem is a weighted interval scheduling problem.
+ *   The intervals are sorted by end time, and the best schedule ending
+ *   before the start of an interval is found by binary search. Its
+ *   complexity is O(n log n).
+ * - 'Auto': the 'IntervalScheduling' engine is selected if all the targets
+ *   of positive profit have a rigid time window, and the 'Unicost' engine
+ *   if they all have the same profit. Otherwise, the engine is selected
+ *   with 'select_dynamic_programming_engine'.
+ *
+ * When only some of the targets have a rigid time window, the 'Pareto'
+ * engine handles them in O(log F) plus the copy of the front: only the
+ * state reaching their release date with the best profit is extended (see
+ * 'compute_pareto_stage').
+ */
+enum class DynamicProgrammingEngine
+{
+    Auto,
+    Pareto,
+    TimeIndexed,
+    Unicost,
+    IntervalScheduling,
+};
+
+std::istream& operator>>(
+        std::istream& in,
+        DynamicProgrammingEngine& engine);
+
+std::ostream& operator<<(
+        std::ostream& os,
+        DynamicProgrammingEngine engine);
+
+/**
+ * Select the engine of the dynamic programming algorithm from the length of
+ * the night and the number of targets.
+ *
+ * A stage of the time-indexed engine costs T operations, while a stage of the
+ * Pareto engine costs the size of its front, which is at most T + 1 but
+ * grows with the number of targets. The time-indexed engine is selected when
+ * the night is at most 10 times longer than the number of targets; on random
+ * nights, this is about where both engines take the same time.
+ */
+DynamicProgrammingEngine select_dynamic_programming_engine(
+        Time horizon,
+        TargetId number_of_targets);
+
+/**
+ * Storage of the states of the Pareto engine.
+ *
+ * - 'AllStages': all stages are kept with their backpointers. It is required
+ *   for the incremental solves, the other schedules of the last stage and the
+ *   marginal values. Its memory is O(n F) where F is the size of a front.
+ * - 'ValueOnly': only the current and the next stages are kept. Only the
+ *   profit of the best schedule is computed. Its memory is O(F).
+ * - 'Checkpoints': the stages are kept every sqrt(n) targets. The schedule is
+ *   retrieved by recomputing the segments between two checkpoints, from the
+ *   last one to the first one. Its memory is O(sqrt(n) F) and it performs
+ *   about twice as many stage computations as 'AllStages'.
+ */
+enum class DynamicProgrammingStorage
+{
+    AllStages,
+    ValueOnly,
+    Checkpoints,
+};
+
+std::istream& operator>>(
+        std::istream& in,
+        DynamicProgrammingStorage& storage);
+
+std::ostream& operator<<(
+        std::ostream& os,
+        DynamicProgrammingStorage storage);
+
 struct DynamicProgrammingOptionalParameters: Parameters
 {
+    /** Engine. */
+    DynamicProgrammingEngine engine = DynamicProgrammingEngine::Auto;
+
+    /**
+     * Number of schedules to return.
+     *
+     * The schedules are the best ones of the Pareto front of the last stage.
+     */
+    Counter number_of_solutions = 1;
+
+    /**
+     * Compute, for each target, the value of the best schedule observing it
+     * and the value of the best schedule not observing it.
+     */
+    bool compute_marginal_values = false;
+
+    /**
+     * Storage of the states of the Pareto engine.
+     *
+     * With 'ValueOnly', no solution is returned; only the bound is set.
+     * 'number_of_solutions' and 'compute_marginal_values' require
+     * 'AllStages'.
+     */
+    DynamicProgrammingStorage storage = DynamicProgrammingStorage::AllStages;
+
+    /**
+     * Threshold.
+     *
+     * Only the schedules of profit greater than the threshold are searched.
+     * If the algorithm proves that there is none, it stops early, the
+     * solution is empty and the bound is the threshold.
+     */
+    Profit threshold = -std::numeric_limits<Profit>::infinity();
+
+    /**
+     * Incumbent solution.
+     *
+     * The threshold is raised to its profit, and it is returned if there is
+     * no better schedule.
+     */
+    const Solution* incumbent = nullptr;
+
+    /**
+     * Relative accuracy of the Pareto engine.
+     *
+     * If positive, the states of the Pareto fronts whose profit is close to
+     * the profit of an earlier state are removed, and the profit of the
+     * returned schedule is at least '1 - epsilon' times the optimal profit.
+     */
+    double epsilon = 0;
+
+    /**
+     * Maximum number of states of the Pareto engine kept in memory.
+     *
+     * The accuracy is decreased as needed to respect it; the resulting
+     * guarantee is reported in the output.
+     */
+    Counter maximum_number_of_states = std::numeric_limits<Counter>::max();
+
+    /**
+     * Split the night into independent segments.
+     *
+     * If the union of the time windows of the targets has gaps, no schedule
+     * carries time across them (see 'compute_night_segments'). Each segment
+     * is then solved by its own dynamic program, and the best schedule is
+     * the concatenation of the best schedules of the segments. The threshold
+     * of a segment is the threshold minus the profit of the targets of
+     * positive profit of the other segments. If a segment stops early, no
+     * schedule of the night has a profit greater than the threshold, so the
+     * night stops early too. The maximum number of states is shared between
+     * the segments. Ignored if 'number_of_solutions' is greater than 1 or if
+     * 'compute_marginal_values' is set.
+     */
+    bool segmentation = false;
+
+    /** Number of threads used to solve the segments concurrently. */
+    Counter number_of_threads = 1;
+
+    virtual nlohmann::json to_json() const override
+    {
+        std::stringstream engine_ss;
+        engine_ss << engine;
+        std::stringstream storage_ss;
+        storage_ss << storage;
+        nlohmann::json json = Parameters::to_json();
+        json.merge_patch({
+                {"Engine", engine_ss.str()},
+                {"Storage", storage_ss.str()},
+                {"NumberOfSolutions", number_of_solutions},
+                {"ComputeMarginalValues", compute_marginal_values},
+                {"Threshold", threshold},
+                {"Incumbent", (incumbent != nullptr)},
+                {"Epsilon", epsilon},
+                {"MaximumNumberOfStates", maximum_number_of_states},
+                {"Segmentation", segmentation},
+                {"NumberOfThreads", number_of_threads}});
+        return json;
+    }
+
+    virtual int format_width() const override { return 28; }
+
+    virtual void format(std::ostream& os) const override
+    {
+        Parameters::format(os);
+        int width = format_width();
+        os
+            << std::setw(width) << std::left << "Engine: " << engine << std::endl
+            << std::setw(width) << std::left << "Storage: " << storage << std::endl
+            << std::setw(width) << std::left << "Number of solutions: " << number_of_solutions << std::endl
+            << std::setw(width) << std::left << "Compute marginal values: " << compute_marginal_values << std::endl
+            << std::setw(width) << std::left << "Threshold: " << threshold << std::endl
+            << std::setw(width) << std::left << "Incumbent: " << (incumbent != nullptr) << std::endl
+            << std::setw(width) << std::left << "Epsilon: " << epsilon << std::endl
+            << std::setw(width) << std::left << "Maximum number of states: " << maximum_number_of_states << std::endl
+            << std::setw(width) << std::left << "Segmentation: " << segmentation << std::endl
+            << std::setw(width) << std::left << "Number of threads: " << number_of_threads << std::endl
+            ;
+    }
+};
+
+struct DynamicProgrammingOutput: Output
+{
+    DynamicProgrammingOutput(
+            const Instance& instance):
+        Output(instance) { }
+
+
+    /** Schedules of positive profit, sorted by decreasing profit. */
+    std::vector<Solution> solutions;
+
+    /**
+     * For each target, value of the best schedule observing it; -inf if the
+     * target can't be observed.
+     */
+    std::vector<Profit> values_with;
+
+    /** For each target, value of the best schedule not observing it. */
+    std::vector<Profit> values_without;
+
+    /**
+     * Guarantee of the solution: its profit is at least 'guarantee' times
+     * the optimal profit.
+     */
+    double guarantee = 1;
 };
 
-const Output dynamic_programming(
+const DynamicProgrammingOutput dynamic_programming(
         const Instance& instance,
         const DynamicProgrammingOptionalParameters& parameters = {});
 
+/**
+ * Index of a state in the state arena.
+ *
+ * 32 bits are enough: 2^31 states would already require 48 GB.
+ */
+using StateId = int32_t;
+
+/**
+ * Dynamic programming solver keeping its workspaces between calls.
+ *
+ * It is meant to be called many times, for example as a pricing oracle: it
+ * doesn't print anything and doesn't build any 'Output'. The targets are
+ * either loaded from an instance or added directly, without building an
+ * instance. Their time data is stored once, sorted by meridian, and only
+ * their profits are modified before each call to 'solve'. Targets with a
+ * non-positive profit are skipped.
+ *
+ * Since the targets are processed in the meridian order, the states of stage
+ * 'target_pos' only depend on the profits of the first 'target_pos' targets.
+ * Therefore, the states are kept between calls and 'solve' restarts from the
+ * first target whose profit has changed. If no profit has changed, 'solve'
+ * returns immediately.
+ *
+ * Each state of the last stage corresponds to a distinct schedule. Besides
+ * the best one, the other schedules of positive profit of the last stage are
+ * available through 'number_of_schedules', 'schedule_profit' and
+ * 'schedule_observations'. A column generation can use them to add several
+ * columns per pricing call.
+ *
+ * 'compute_marginal_values' runs a backward pass in the reverse meridian
+ * order. A state of the backward pass at position 'target_pos' is a schedule
+ * of the targets from position 'target_pos' and stores the opposite of the
+ * latest time at which the telescope must be free to perform it. This is the
+ * forward dynamic program on the reversed time axis, so both passes share
+ * the same stage computation. Then, for each target, the forward stage before
+ * it and the backward stage after it are combined to get the best value of a
+ * schedule observing it and of a schedule not observing it.
+ *
+ * With a storage other than 'AllStages' (see 'set_storage'), 'solve' uses
+ * the Pareto engine and recomputes all stages at each call, but only keeps a
+ * few of them in memory.
+ *
+ * With a threshold (see 'set_threshold'), 'solve' only searches the
+ * schedules of profit greater than the threshold. Before each stage, an
+ * upper bound on the profit of the observations of the remaining targets is
+ * known: the sum of their positive profits, and the time left before their
+ * latest deadline times their best profit per time unit. As soon as no state
+ * can reach the threshold with this bound, 'solve' stops. With a storage
+ * other than 'AllStages', the states which can't reach the threshold are
+ * also removed from the stages. With 'AllStages', they are kept so that the
+ * stages stay valid for the incremental solves.
+ *
+ * With an approximation (see 'set_epsilon' and
+ * 'set_maximum_number_of_states'), the Pareto engine removes from each stage
+ * the states whose profit is within a factor 1 + delta of the profit of an
+ * earlier state (see 'trim_front'). Along a schedule, the factors of the
+ * stages multiply, so with n targets and delta = (1 - epsilon)^(-1/n) - 1,
+ * the best schedule found is at least '1 - epsilon' times the optimal one.
+ * If a stage still has too many states, its factor is increased; 'guarantee'
+ * returns the resulting guarantee. The other engines are exact.
+ */
+class DynamicProgrammingSolver
+{
+
+public:
+
+    /** Constructor. */
+    DynamicProgrammingSolver() { clear(); }
+
+    /** Remove all targets. */
+    void clear();
+
+    /**
+     * Add a target.
+     *
+     * The id of the target is the number of targets added before it. Targets
+     * are sorted by meridian at the next call to 'solve'.
+     */
+    TargetId add_target(
+            Time release_date,
+            Time meridian,
+            Time deadline,
+            Time observation_time,
+            Profit profit = 0);
+
+    /** Set the targets and their profits from an instance. */
+    void set_instance(const Instance& instance);
+
+    /**
+     * Set the engine used by 'solve'.
+     *
+     * The other schedules of the last stage and the marginal values are
+     * always computed with the Pareto engine.
+     */
+    void set_engine(DynamicProgrammingEngine engine) { engine_ = engine; }
+
+    /**
+     * Set the storage of the states used by 'solve'.
+     *
+     * With 'ValueOnly', 'observations' is empty after 'solve'. With a storage
+     * other than 'AllStages', the other schedules of the last stage are not
+     * available.
+     */
+    void set_storage(DynamicProgrammingStorage storage)
+    {
+        if (storage_ == storage)
+            return;
+        storage_ = storage;
+        light_up_to_date_ = false;
+    }
+
+    /** Set the profit of a target for the next call to 'solve'. */
+    void set_profit(
+            TargetId target_id,
+            Profit profit)
+    {
+        TargetId target_pos = positions_[target_id];
+        if (profits_[target_pos] == profit)
+            return;
+        // All targets of non-positive profit are skipped the same way.
+        if (profits_[target_pos] > 0 || profit > 0) {
+            first_changed_pos_ = (std::min)(first_changed_pos_, target_pos);
+            time_indexed_up_to_date_ = false;
+            unicost_up_to_date_ = false;
+            interval_scheduling_up_to_date_ = false;
+            light_up_to_date_ = false;
+        }
+        profits_[target_pos] = profit;
+    }
+
+    /**
+     * Set the threshold for the next calls to 'solve'.
+     *
+     * If no schedule has a profit greater than the threshold, 'solve' may
+     * stop early; then 'profit' returns 0, 'observations' is empty and
+     * 'bound' returns the threshold. In column generation, the threshold of
+     * a pricing subproblem is the dual value of its night.
+     */
+    void set_threshold(Profit threshold)
+    {
+        if (threshold_ == threshold)
+            return;
+        threshold_ = threshold;
+        time_indexed_up_to_date_ = false;
+        unicost_up_to_date_ = false;
+        light_up_to_date_ = false;
+    }
+
+    /**
+     * Set the relative accuracy of the Pareto engine for the next calls to
+     * 'solve'.
+     *
+     * 'epsilon' must be in [0, 1); 0 means exact.
+     */
+    void set_epsilon(double epsilon)
+    {
+        if (epsilon < 0 || epsilon >= 1) {
+            throw std::invalid_argument(
+                    "single_night_star_observation_scheduling::DynamicProgrammingSolver::set_epsilon\n"
+                    "'epsilon' must be in [0, 1).");
+        }
+        if (epsilon_ == epsilon)
+            return;
+        epsilon_ = epsilon;
+        first_changed_pos_ = 0;
+        light_up_to_date_ = false;
+    }
+
+    /**
+     * Set the maximum number of states of the Pareto engine kept in memory
+     * for the next calls to 'solve'.
+     *
+     * It is shared between the stages kept by the storage: all the stages
+     * with 'AllStages', the current and the next ones with 'ValueOnly', and
+     * the checkpoints and the stages of a segment with 'Checkpoints'. A
+     * stage keeps at least 3 states.
+     */
+    void set_maximum_number_of_states(Counter maximum_number_of_states)
+    {
+        if (maximum_number_of_states_ == maximum_number_of_states)
+            return;
+        maximum_number_of_states_ = maximum_number_of_states;
+        first_changed_pos_ = 0;
+        light_up_to_date_ = false;
+    }
+
+    /** Solve the problem and return the profit of the best schedule. */
+    Profit solve();
+
+    /*
+     * Getters
+     */
+
+    /** Get the number of targets. */
+    TargetId number_of_targets() const { return sorted_targets_.size(); }
+
+    /**
+     * Get the length of the night, from the earliest non-negative release
+     * date to the latest deadline.
+     */
+    Time horizon() const
+    {
+        if (sorted_targets_.empty())
+            return 0;
+        return std::max((Time)0, latest_deadline_ - time_origin());
+    }
+
+    /** Get the profit of the best schedule found by the last call to 'solve'. */
+    Profit profit() const { return profit_; }
+
+    /**
+     * Get the guarantee of the last call to 'solve': the profit of the best
+     * schedule found is at least 'guarantee' times the optimal profit.
+     */
+    double guarantee() const { return guarantee_; }
+
+    /**
+     * Get an upper bound on the profit of the best schedule, computed by the
+     * last call to 'solve'.
+     */
+    Profit bound() const { return ((early_exit_)? threshold_: profit_) / guarantee_; }
+
+    /**
+     * Return 'true' iff the last call to 'solve' stopped early because no
+     * schedule has a profit greater than the threshold.
+     */
+    bool stopped_early() const { return early_exit_; }
+
+    /** Get the observations of the best schedule found by the last call to 'solve'. */
+    const std::vector<Observation>& observations() const { return observations_; }
+
+    /**
+     * Compute the marginal values of the targets.
+     *
+     * This solves the problem with the Pareto engine first, without threshold
+     * and without approximation.
+     */
+    void compute_marginal_values();
+
+    /**
+     * Get the value of the best schedule observing a target; -inf if the
+     * target can't be observed.
+     *
+     * 'compute_marginal_values' must have been called since the last
+     * modification of the profits.
+     */
+    Profit value_with(TargetId target_id) const { return values_with_[positions_[target_id]]; }
+
+    /** Get the value of the best schedule not observing a target. */
+    Profit value_without(TargetId target_id) const { return values_without_[positions_[target_id]]; }
+
+    /** Get the observations of the best schedule observing a target. */
+    void schedule_with(
+            TargetId target_id,
+            std::vector<Observation>& observations) const;
+
+    /**
+     * Get the number of schedules of positive profit in the last stage of the
+     * last call to 'solve'.
+     */
+    Counter number_of_schedules() const;
+
+    /**
+     * Get the profit of a schedule of the last stage.
+     *
+     * Schedules are sorted by decreasing profit; schedule 0 is the best one.
+     */
+    Profit schedule_profit(Counter schedule_pos) const
+    {
+        return states_.profits[stage_ends_.back() - 1 - schedule_pos];
+    }
+
+    /** Get the observations of a schedule of the last stage. */
+    void schedule_observations(
+            Counter schedule_pos,
+            std::vector<Observation>& observations) const
+    {
+        retrieve_observations(stage_ends_.back() - 1 - schedule_pos, observations);
+    }
+
+private:
+
+    /*
+     * Private methods
+     */
+
+    /** Sort the targets by meridian. */
+    void sort_targets();
+
+    /** Get the time of index 0 of the time-indexed engine. */
+    Time time_origin() const { return std::max((Time)0, earliest_release_date_); }
+
+    /**
+     * Compute the suffix bounds of the targets.
+     *
+     * Only needed with a threshold.
+     */
+    void compute_suffix_bounds();
+
+    /**
+     * Get an upper bound on the profit of the observations of the targets
+     * from position 'target_pos' for a schedule ending at time 'time'.
+     */
+    Profit suffix_bound(
+            TargetId target_pos,
+            Time time) const
+    {
+        if (suffix_profits_[target_pos] <= 0)
+            return 0;
+        if (suffix_densities_[target_pos] == std::numeric_limits<Profit>::infinity())
+            return suffix_profits_[target_pos];
+        Time capacity = suffix_deadlines_[target_pos]
+            - std::max(time, suffix_release_dates_[target_pos]);
+        if (capacity <= 0)
+            return 0;
+        return std::min(
+                suffix_profits_[target_pos],
+                suffix_densities_[target_pos] * capacity);
+    }
+
+    /**
+     * Return 'true' iff no schedule of a stage before target 'target_pos'
+     * can reach the threshold.
+     *
+     * The states of a stage are sorted by increasing time and profit, and
+     * the suffix bound doesn't increase with time, so the bound of the stage
+     * is the bound of its first state with the profit of its last state.
+     */
+    bool below_threshold(
+            const ParetoStates& states,
+            StateId stage_start,
+            StateId stage_end,
+            TargetId target_pos) const
+    {
+        return stage_start == stage_end
+            || states.profits[stage_end - 1]
+            + suffix_bound(target_pos, states.times[stage_start])
+            <= threshold_;
+    }
+
+    /**
+     * Remove the states of a stage before target 'target_pos' which can't
+     * reach the threshold.
+     *
+     * The stage must be at the end of 'states'.
+     */
+    void prune_stage(
+            ParetoStates& states,
+            StateId stage_start,
+            TargetId target_pos) const;
+
+    /** Return 'true' iff the Pareto engine is approximate. */
+    bool approximate() const
+    {
+        return epsilon_ > 0
+            || maximum_number_of_states_ < std::numeric_limits<Counter>::max();
+    }
+
+    /**
+     * Compute the factor and the maximum number of states of the stages of
+     * the approximate Pareto engine.
+     */
+    void compute_trim_parameters();
+
+    /**
+     * Remove the states of a stage at the end of 'states' whose profit is
+     * close to the profit of an earlier state.
+     *
+     * Return the ratio by which the profit of the stage may have decreased.
+     */
+    double trim_stage(
+            ParetoStates& states,
+            StateId stage_start) const
+    {
+        return starobservationschedulingsolver::trim_front(
+                states,
+                stage_start,
+                trim_factor_,
+                stage_maximum_number_of_states_);
+    }
+
+    /**
+     * Solve the problem with the Pareto engine.
+     *
+     * The threshold and the approximation are ignored when 'exact' is
+     * 'true'.
+     */
+    void solve_pareto(bool exact = false);
+
+    /** Solve the problem with the time-indexed engine. */
+    void solve_time_indexed();
+
+    /**
+     * Return 'true' iff all the targets of positive profit have the same
+     * profit.
+     */
+    bool has_unit_profits() const;
+
+    /** Solve the problem with the unicost engine. */
+    void solve_unicost();
+
+    /**
+     * Return 'true' iff all the targets of positive profit have a rigid time
+     * window.
+     */
+    bool has_rigid_windows() const;
+
+    /** Solve the problem with the interval scheduling engine. */
+    void solve_interval_scheduling();
+
+    /**
+     * Solve the problem with the Pareto engine without keeping all the
+     * stages.
+     */
+    void solve_pareto_light();
+
+    /** Retrieve the observations of the schedule of a state. */
+    void retrieve_observations(
+            StateId state_id,
+            std::vector<Observation>& observations) const;
+
+    /*
+     * Private attributes
+     */
+
+    /** Engine. */
+    DynamicProgrammingEngine engine_ = DynamicProgrammingEngine::Pareto;
+
+    /** Storage. */
+    DynamicProgrammingStorage storage_ = DynamicProgrammingStorage::AllStages;
+
+    /** 'true' iff the targets are sorted by meridian. */
+    bool sorted_ = true;
+
+    /** Earliest release date. */
+    Time earliest_release_date_ = std::numeric_limits<Time>::max();
+
+    /** Latest deadline. */
+    Time latest_deadline_ = std::numeric_limits<Time>::min();
+
+    /** Targets sorted by meridian. */
+    std::vector<TargetId> sorted_targets_;
+
+    /** Position of each target in 'sorted_targets_'. */
+    std::vector<TargetId> positions_;
+
+    /** Release dates of the targets, in the meridian order. */
+    std::vector<Time> release_dates_;
+
+    /** Meridians of the targets, in the meridian order. */
+    std::vector<Time> meridians_;
+
+    /** Deadlines of the targets, in the meridian order. */
+    std::vector<Time> deadlines_;
+
+    /** Observation times of the targets, in the meridian order. */
+    std::vector<Time> observation_times_;
+
+    /** Profits of the targets, in the meridian order. */
+    std::vector<Profit> profits_;
+
+    /**
+     * State arena.
+     *
+     * The states of stage 'target_pos' are stored between
+     * 'stage_starts_[target_pos]' and 'stage_ends_[target_pos]'. If a target
+     * is skipped, the next stage shares the states of the current one.
+     *
+     * The label of a state is the position in the meridian order of its last
+     * observed target.
+     */
+    ParetoStates states_;
+
+    /** Start of each stage in the state arena. */
+    std::vector<StateId> stage_starts_;
+
+    /** Buffers for the computation of the stages of the Pareto engine. */
+    starobservationschedulingsolver::ParetoStageBuffers pareto_stage_buffers_;
+
+    /** End of each stage in the state arena. */
+    std::vector<StateId> stage_ends_;
+
+    /**
+     * Position of the first target whose profit has changed since the last
+     * call to 'solve'.
+     *
+     * The stages up to this position are still valid.
+     */
+    TargetId first_changed_pos_ = 0;
+
+    /** Profit of the best schedule. */
+    Profit profit_ = 0;
+
+    /** Threshold. */
+    Profit threshold_ = -std::numeric_limits<Profit>::infinity();
+
+    /**
+     * 'true' iff the last call to 'solve' stopped early because no schedule
+     * has a profit greater than the threshold.
+     */
+    bool early_exit_ = false;
+
+    /**
+     * Sum of the positive profits of the targets from each position in the
+     * meridian order.
+     */
+    std::vector<Profit> suffix_profits_;
+
+    /**
+     * Best profit per time unit of the targets of positive profit from each
+     * position; infinity if one of them has an observation time of 0.
+     */
+    std::vector<Profit> suffix_densities_;
+
+    /** Earliest release date of the targets of positive profit from each position. */
+    std::vector<Time> suffix_release_dates_;
+
+    /** Latest deadline of the targets of positive profit from each position. */
+    std::vector<Time> suffix_deadlines_;
+
+    /** Relative accuracy of the Pareto engine. */
+    double epsilon_ = 0;
+
+    /** Maximum number of states of the Pareto engine. */
+    Counter maximum_number_of_states_ = std::numeric_limits<Counter>::max();
+
+    /** Factor of the stages of the approximate Pareto engine. */
+    double trim_factor_ = 1;
+
+    /** Maximum number of states of a stage of the approximate Pareto engine. */
+    Counter stage_maximum_number_of_states_ = std::numeric_limits<Counter>::max();
+
+    /** Guarantee of the last call to 'solve'. */
+    double guarantee_ = 1;
+
+    /**
+     * Guarantee of each stage of the state arena: for each schedule of the
+     * targets before the stage, the stage has a state ending earlier whose
+     * profit is at least the guarantee times the profit of the schedule.
+     */
+    std::vector<double> stage_guarantees_;
+
+    /** 'true' iff the stages of the state arena are approximate. */
+    bool approximate_stages_ = false;
+
+    /** Observations of the best schedule. */
+    std::vector<Observation> observations_;
+
+    /**
+     * 'true' iff no profit has changed since the last call to
+     * 'solve_time_indexed'.
+     */
+    bool time_indexed_up_to_date_ = false;
+
+    /**
+     * Values of the time-indexed engine.
+     *
+     * 'values_[t]' is the best profit of a schedule for which the telescope
+     * is free at time 'time_origin() + t'.
+     */
+    std::vector<Profit> values_;
+
+    /** Buffer for the values extended with a target. */
+    std::vector<Profit> extended_values_;
+
+    /**
+     * Decisions of the time-indexed engine.
+     *
+     * The decisions of stage 'target_pos' are the ones of the times between
+     * 'decision_first_times_[target_pos]' and
+     * 'decision_last_times_[target_pos]'. They are stored from
+     * 'decision_starts_[target_pos]'. 0 means that the value comes from the
+     * previous time, 1 that the target is not observed and 2 that it is
+     * observed and ends at this time. Outside of these times, the target is
+     * not observed.
+     */
+    std::vector<uint8_t> decisions_;
+
+    /** Start of the decisions of each stage. */
+    std::vector<int64_t> decision_starts_;
+
+    /** First time of the decisions of each stage. */
+    std::vector<Time> decision_first_times_;
+
+    /** Last time of the decisions of each stage. */
+    std::vector<Time> decision_last_times_;
+
+    /**
+     * 'true' iff no profit has changed since the last call to
+     * 'solve_unicost'.
+     */
+    bool unicost_up_to_date_ = false;
+
+    /**
+     * Earliest end times of the unicost engine.
+     *
+     * 'count_times_[k]' is the earliest end time of a schedule of 'k'
+     * observations; max if there is none.
+     */
+    std::vector<Time> count_times_;
+
+    /** Buffer for the end times extended with a target. */
+    std::vector<Time> extended_count_times_;
+
+    /**
+     * Decisions of the unicost engine.
+     *
+     * The decisions of stage 'target_pos' are stored between
+     * 'count_decision_starts_[target_pos]' and
+     * 'count_decision_starts_[target_pos + 1]'. Decision 'k' is 1 iff the
+     * best schedule of 'k + 1' observations after the stage observes the
+     * target. Beyond them, the target is not observed.
+     */
+    std::vector<uint8_t> count_decisions_;
+
+    /** Start of the decisions of each stage. */
+    std::vector<int64_t> count_decision_starts_;
+
+    /**
+     * 'true' iff no profit has changed since the last call to
+     * 'solve_interval_scheduling'.
+     */
+    bool interval_scheduling_up_to_date_ = false;
+
+    /** 'true' iff 'interval_order_' and 'interval_predecessors_' are up to date. */
+    bool interval_order_up_to_date_ = false;
+
+    /**
+     * Positions of the targets which can be observed during a fixed
+     * interval, sorted by end time, and for equal end times, by start time.
+     */
+    std::vector<TargetId> interval_order_;
+
+    /**
+     * For each interval of 'interval_order_', number of intervals before it
+     * which end before its start.
+     */
+    std::vector<TargetId> interval_predecessors_;
+
+    /**
+     * Values of the interval scheduling engine.
+     *
+     * 'interval_values_[k]' is the best profit of a schedule of the first
+     * 'k' intervals.
+     */
+    std::vector<Profit> interval_values_;
+
+    /**
+     * Decisions of the interval scheduling engine; decision 'k' is 1 iff the
+     * best schedule of the first 'k + 1' intervals observes interval 'k'.
+     */
+    std::vector<uint8_t> interval_decisions_;
+
+    /**
+     * 'true' iff no profit has changed since the last call to
+     * 'solve_pareto_light'.
+     */
+    bool light_up_to_date_ = false;
+
+    /** Current and next stages of 'solve_pareto_light'. */
+    ParetoStates fronts_[2];
+
+    /**
+     * States of the checkpoints.
+     *
+     * Checkpoint 'checkpoint_pos' is the stage before target
+     * 'checkpoint_pos * checkpoint_interval_'. Its states are stored between
+     * 'checkpoint_starts_[checkpoint_pos]' and
+     * 'checkpoint_starts_[checkpoint_pos + 1]'.
+     */
+    ParetoStates checkpoints_;
+
+    /** Start of each checkpoint. */
+    std::vector<StateId> checkpoint_starts_;
+
+    /** Number of targets between two checkpoints. */
+    TargetId checkpoint_interval_ = 1;
+
+    /**
+     * State arena of the segment being recomputed.
+     *
+     * The first states are the ones of the checkpoint at the start of the
+     * segment. Their label is -1 and their previous state is their position
+     * in the checkpoint; the states which are copies of them keep this label
+     * and this previous state.
+     */
+    ParetoStates segment_states_;
+
+    /**
+     * State arena of the backward pass.
+     *
+     * The time of a backward state is the opposite of the latest time at
+     * which the telescope must be free to perform its schedule.
+     */
+    ParetoStates backward_states_;
+
+    /** Start of each stage in the backward state arena. */
+    std::vector<StateId> backward_stage_starts_;
+
+    /** End of each stage in the backward state arena. */
+    std::vector<StateId> backward_stage_ends_;
+
+    /** Value of the best schedule observing each target, in the meridian order. */
+    std::vector<Profit> values_with_;
+
+    /** Value of the best schedule not observing each target, in the meridian order. */
+    std::vector<Profit> values_without_;
+
+    /**
+     * Forward and backward states of the best schedule observing each
+     * target, in the meridian order.
+     */
+    std::vector<std::pair<StateId, StateId>> best_with_states_;
+
+};
+
 }
 }
-
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include "starobservationschedulingsolver/utils/types.hpp"
+
 #include <cstdint>
 #include <vector>
 #include <iostream>
@@ -25,9 +27,9 @@ namespace starobservationschedulingsolver
 namespace single_night_star_observation_scheduling
 {
 
-using TargetId = int64_t;
+using TargetId = IdType;
 using Profit = double;
-using Time = int64_t;
+using Time = TimeType;
 using Counter = int64_t;
 using Seed = int64_t;
 
@@ -23,6 +23,9 @@ public:
             Time observation_time,
             Profit profit);
 
+    /** Set the profit of all targets to 1. */
+    void set_unicost();
+
     /** Read an instance from a file. */
     void read(
             const std::string& instance_path,
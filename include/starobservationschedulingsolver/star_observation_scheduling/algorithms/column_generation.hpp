@@ -10,6 +10,115 @@ namespace star_observation_scheduling
 struct ColumnGenerationOptionalParameters: Parameters
 {
     std::string linear_programming_solver = "CLP";
+
+    /**
+     * Number of threads used to solve the pricing problem.
+     *
+     * The nights are priced concurrently. If the instance has several
+     * connected components, they are solved independently and concurrently,
+     * and the threads are shared between them.
+     */
+    Counter number_of_threads = 1;
+
+    /**
+     * Maximum number of columns generated per night at each pricing call.
+     *
+     * Besides the best schedule of a night, the other schedules of positive
+     * reduced cost of the last stage of its dynamic program are added.
+     */
+    Counter number_of_columns_per_night = 1;
+
+    /**
+     * Solve the pricing subproblems without keeping all the stages of their
+     * dynamic programs.
+     *
+     * Each night is first solved value-only. Only the nights with a positive
+     * reduced cost are solved again, with checkpoints, to retrieve their
+     * column. The memory of a subproblem is then O(sqrt(n) F) instead of
+     * O(n F), but its stages are recomputed at each pricing call and at most
+     * one column is generated per night.
+     */
+    bool value_only_pricing = false;
+
+    /**
+     * Relative accuracy of the approximate pricing.
+     *
+     * If positive, the pricing subproblems are first solved with an
+     * approximate dynamic program whose best schedule is at least
+     * '1 - pricing_epsilon' times the optimal one. They are only solved
+     * exactly if no column is found. Once this happens, the next pricings of
+     * the same column generation are exact, so that the subproblems keep
+     * the same accuracy and their dynamic programs restart from the first
+     * target whose profit has changed.
+     */
+    double pricing_epsilon = 0;
+
+    /**
+     * Maximum number of states of the dynamic program of a pricing
+     * subproblem during the approximate pricing.
+     *
+     * If set, the approximate pricing is used even with a 'pricing_epsilon'
+     * of 0, and its accuracy is decreased as needed to respect it.
+     */
+    Counter pricing_maximum_number_of_states = std::numeric_limits<Counter>::max();
+
+    /**
+     * Split the pricing subproblem of each night into independent segments.
+     *
+     * If the union of the time windows of the observables of a night has
+     * gaps, each segment between two gaps gets its own subproblem solver,
+     * and the column of the night is the concatenation of the best
+     * schedules of its segments. The segments of all nights are priced
+     * concurrently. The threshold of a segment is the dual value of its
+     * night minus the positive reduced profits of the other segments of the
+     * night; with 'value_only_pricing', the segments are solved with
+     * checkpoints directly. Ignored if 'number_of_columns_per_night' is
+     * greater than 1.
+     */
+    bool segmented_pricing = false;
+
+    /**
+     * Solve the connected components of the instance independently.
+     *
+     * The solution is the union of the solutions of the components and the
+     * bound the sum of their bounds. Since the bound of each component is
+     * rounded up separately, it may exceed the bound of the whole instance
+     * by less than the number of components.
+     */
+    bool decomposition = true;
+
+    virtual nlohmann::json to_json() const override
+    {
+        nlohmann::json json = Parameters::to_json();
+        json.merge_patch({
+                {"LinearProgrammingSolver", linear_programming_solver},
+                {"NumberOfThreads", number_of_threads},
+                {"NumberOfColumnsPerNight", number_of_columns_per_night},
+                {"ValueOnlyPricing", value_only_pricing},
+                {"PricingEpsilon", pricing_epsilon},
+                {"PricingMaximumNumberOfStates", pricing_maximum_number_of_states},
+                {"SegmentedPricing", segmented_pricing},
+                {"Decomposition", decomposition}});
+        return json;
+    }
+
+    virtual int format_width() const override { return 37; }
+
+    virtual void format(std::ostream& os) const override
+    {
+        Parameters::format(os);
+        int width = format_width();
+        os
+            << std::setw(width) << std::left << "Linear programming solver: " << linear_programming_solver << std::endl
+            << std::setw(width) << std::left << "Number of threads: " << number_of_threads << std::endl
+            << std::setw(width) << std::left << "Number of columns per night: " << number_of_columns_per_night << std::endl
+            << std::setw(width) << std::left << "Value-only pricing: " << value_only_pricing << std::endl
+            << std::setw(width) << std::left << "Pricing epsilon: " << pricing_epsilon << std::endl
+            << std::setw(width) << std::left << "Pricing maximum number of states: " << pricing_maximum_number_of_states << std::endl
+            << std::setw(width) << std::left << "Segmented pricing: " << segmented_pricing << std::endl
+            << std::setw(width) << std::left << "Decomposition: " << decomposition << std::endl
+            ;
+    }
 };
 
 struct ColumnGenerationGreedyOutput: Output
@@ -20,22 +20,26 @@
 
 #pragma once
 
+#include "starobservationschedulingsolver/utils/types.hpp"
+#include "starobservationschedulingsolver/utils/span.hpp"
+
 #include <cstdint>
 #include <string>
 #include <vector>
 #include <limits>
+#include <algorithm>
 
 namespace starobservationschedulingsolver
 {
 namespace star_observation_scheduling
 {
 
-using NightId = int64_t;
-using TargetId = int64_t;
-using ObservableId = int64_t;
-using ObservablePos = int64_t;
-using Profit = double;
-using Time = int64_t;
+using NightId = IdType;
+using TargetId = IdType;
+using ObservableId = IdType;
+using ObservablePos = IdType;
+using Profit = IntegerProfitType;
+using Time = TimeType;
 using Counter = int64_t;
 using Seed = int64_t;
 
@@ -47,8 +51,14 @@ struct Target
     /** Profit of the target. */
     Profit profit = 0;
 
-    /** Observables of the target. */
-    std::vector<std::pair<NightId, ObservableId>> observables;
+    /**
+     * Position of the first observable of the target in the target
+     * observable array of the instance.
+     */
+    Counter observables_start = 0;
+
+    /** Number of observables of the target. */
+    Counter number_of_observables = 0;
 };
 
 /**
@@ -72,6 +82,24 @@ struct Observable
     Time observation_time;
 };
 
+/**
+ * Structure for an observation fixed by the reduction of an instance.
+ */
+struct FixedObservation
+{
+    /** Original id of the observable. */
+    ObservableId original_observable_id;
+
+    /** Original id of the target. */
+    TargetId original_target_id;
+
+    /** Start time. */
+    Time start_time;
+
+    /** End time. */
+    Time end_time;
+};
+
 struct Night
 {
     /** Observables of the night. */
@@ -82,6 +110,80 @@ struct Night
 
     /** End time. */
     Time end = std::numeric_limits<Time>::min();
+
+    /**
+     * Original ids of the observables of the night; empty if the instance
+     * is not reduced.
+     */
+    std::vector<ObservableId> original_observable_ids;
+
+    /**
+     * Observations of the night fixed by the reduction, sorted by start
+     * time.
+     */
+    std::vector<FixedObservation> fixed_observations;
+};
+
+/**
+ * Structure of arrays storing the observables of a night.
+ *
+ * The observables are sorted by increasing meridian. Position 'pos' of each
+ * array corresponds to observable 'observable_ids[pos]' of the night. Scans
+ * over a single attribute of the observables of a night only touch
+ * contiguous memory.
+ */
+struct NightObservables
+{
+    /** Ids of the observables. */
+    std::vector<ObservableId> observable_ids;
+
+    /** Targets of the observables. */
+    std::vector<TargetId> target_ids;
+
+    /** Release dates of the observables. */
+    std::vector<Time> release_dates;
+
+    /** Meridians of the observables. */
+    std::vector<Time> meridians;
+
+    /** Deadlines of the observables. */
+    std::vector<Time> deadlines;
+
+    /** Observation times of the observables. */
+    std::vector<Time> observation_times;
+};
+
+/**
+ * Structure for a connected component of an instance.
+ *
+ * The nights and the targets are the vertices of a bipartite graph with an
+ * edge between a night and a target for each observable. Nights and targets
+ * of different components never interact, so the components can be solved
+ * independently. Nights and targets without observable don't belong to any
+ * component.
+ */
+struct Component
+{
+    /**
+     * Position of the first night of the component in the component night
+     * array of the instance.
+     */
+    Counter nights_start = 0;
+
+    /** Number of nights. */
+    Counter number_of_nights = 0;
+
+    /**
+     * Position of the first target of the component in the component target
+     * array of the instance.
+     */
+    Counter targets_start = 0;
+
+    /** Number of targets. */
+    Counter number_of_targets = 0;
+
+    /** Number of observables. */
+    Counter number_of_observables = 0;
 };
 
 /**
@@ -119,9 +221,147 @@ public:
         return nights_[night_id].observables[observable_id];
     }
 
+    /**
+     * Return 'true' iff the observables of the nights are also stored as
+     * structures of arrays, see 'InstanceBuilder::set_night_observables'.
+     */
+    bool has_night_observables() const { return !night_observables_.empty(); }
+
+    /**
+     * Get the observables of a night, stored as a structure of arrays.
+     *
+     * Only available if 'has_night_observables()' returns 'true'.
+     */
+    const NightObservables& night_observables(NightId night_id) const { return night_observables_[night_id]; }
+
+    /** Compute the observables of a night as a structure of arrays. */
+    NightObservables compute_night_observables(NightId night_id) const;
+
+    /** Get the observables of a target, as (night, observable) pairs. */
+    Span<std::pair<NightId, ObservableId>> observables(TargetId target_id) const
+    {
+        const Target& target = targets_[target_id];
+        return {target_observables_.data() + target.observables_start, target.number_of_observables};
+    }
+
+    /**
+     * Get the observable of a target during a night.
+     *
+     * The observables of the target are searched by dichotomy. If the target
+     * has several observables during the night, return the first one.
+     *
+     * Return -1 if the target is not observable during the night.
+     */
+    ObservableId observable_id(
+            NightId night_id,
+            TargetId target_id) const
+    {
+        Span<std::pair<NightId, ObservableId>> observables = this->observables(target_id);
+        auto it = std::lower_bound(
+                observables.begin(),
+                observables.end(),
+                night_id,
+                [](const std::pair<NightId, ObservableId>& observable, NightId night_id)
+                {
+                    return observable.first < night_id;
+                });
+        if (it == observables.end() || it->first != night_id)
+            return -1;
+        return it->second;
+    }
+
     /** Get the total profit of the targets. */
     Profit total_profit() const { return profit_sum_; }
 
+    /** Get the number of connected components. */
+    Counter number_of_components() const { return components_.size(); }
+
+    /** Get a connected component. */
+    const Component& component(Counter component_id) const { return components_[component_id]; }
+
+    /** Get the nights of a component, sorted by id. */
+    Span<NightId> component_nights(Counter component_id) const
+    {
+        const Component& component = components_[component_id];
+        return {component_nights_.data() + component.nights_start, component.number_of_nights};
+    }
+
+    /** Get the targets of a component, sorted by id. */
+    Span<TargetId> component_targets(Counter component_id) const
+    {
+        const Component& component = components_[component_id];
+        return {component_targets_.data() + component.targets_start, component.number_of_targets};
+    }
+
+    /** Get the component of a night; -1 if it has no observable. */
+    Counter night_component(NightId night_id) const { return night_components_[night_id]; }
+
+    /** Get the component of a target; -1 if it has no observable. */
+    Counter target_component(TargetId target_id) const { return target_components_[target_id]; }
+
+    /*
+     * Reduction
+     */
+
+    /** Return 'true' iff the instance has been reduced when it was built. */
+    bool reduced() const { return reduced_; }
+
+    /** Get the original id of a target. */
+    TargetId original_target_id(TargetId target_id) const
+    {
+        return (reduced_)? original_target_ids_[target_id]: target_id;
+    }
+
+    /** Get the original id of an observable. */
+    ObservableId original_observable_id(
+            NightId night_id,
+            ObservableId observable_id) const
+    {
+        return (reduced_)?
+            nights_[night_id].original_observable_ids[observable_id]:
+            observable_id;
+    }
+
+    /**
+     * Get the profit of the targets fixed by the reduction.
+     *
+     * It is included in 'total_profit' and in the profit of the solutions.
+     */
+    Profit fixed_profit() const { return fixed_profit_; }
+
+    /** Get the number of targets fixed by the reduction. */
+    TargetId number_of_fixed_targets() const { return number_of_fixed_targets_; }
+
+    /**
+     * Get the number of observables removed by the reduction because their
+     * observation time doesn't fit in their time window.
+     */
+    Counter number_of_infeasible_observables() const { return number_of_infeasible_observables_; }
+
+    /** Get the number of targets removed by the reduction because their profit is not positive. */
+    TargetId number_of_unprofitable_targets() const { return number_of_unprofitable_targets_; }
+
+    /**
+     * Get the number of observables removed by the reduction because another
+     * observable of the same target during the same night dominates them.
+     */
+    Counter number_of_dominated_observables() const { return number_of_dominated_observables_; }
+
+    /**
+     * Get the number of observables removed by the reduction because their
+     * target is fixed to another one of its observables.
+     */
+    Counter number_of_observables_of_fixed_targets() const { return number_of_observables_of_fixed_targets_; }
+
+    /**
+     * Build the instance of a component.
+     *
+     * Night 'pos' and target 'pos' of the component instance are the nights
+     * and the targets at position 'pos' in 'component_nights' and
+     * 'component_targets'. The observables of a night keep their ids.
+     */
+    Instance component_instance(Counter component_id) const;
+
     /*
      * Export
      */
@@ -170,6 +410,60 @@ private:
     /** Sum of the profits of the targets. */
     Profit profit_sum_ = 0;
 
+    /**
+     * Observables of the nights, stored as structures of arrays; empty if
+     * they are not requested.
+     */
+    std::vector<NightObservables> night_observables_;
+
+    /**
+     * Observables of all targets, stored target by target, and sorted by
+     * night for each target.
+     */
+    std::vector<std::pair<NightId, ObservableId>> target_observables_;
+
+    /** Connected components, sorted by smallest night id. */
+    std::vector<Component> components_;
+
+    /** Nights of all components, stored component by component. */
+    std::vector<NightId> component_nights_;
+
+    /** Targets of all components, stored component by component. */
+    std::vector<TargetId> component_targets_;
+
+    /** Component of each night. */
+    std::vector<Counter> night_components_;
+
+    /** Component of each target. */
+    std::vector<Counter> target_components_;
+
+    /** Position of each target in the targets of its component. */
+    std::vector<TargetId> target_component_positions_;
+
+    /** 'true' iff the instance has been reduced. */
+    bool reduced_ = false;
+
+    /** Original id of each target if the instance is reduced. */
+    std::vector<TargetId> original_target_ids_;
+
+    /** Profit of the fixed targets. */
+    Profit fixed_profit_ = 0;
+
+    /** Number of fixed targets. */
+    TargetId number_of_fixed_targets_ = 0;
+
+    /** Number of infeasible observables. */
+    Counter number_of_infeasible_observables_ = 0;
+
+    /** Number of unprofitable targets. */
+    TargetId number_of_unprofitable_targets_ = 0;
+
+    /** Number of dominated observables. */
+    Counter number_of_dominated_observables_ = 0;
+
+    /** Number of removed observables of the fixed targets. */
+    Counter number_of_observables_of_fixed_targets_ = 0;
+
     friend class InstanceBuilder;
 
 };
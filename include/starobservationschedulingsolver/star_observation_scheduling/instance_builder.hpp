@@ -35,6 +35,37 @@ public:
             TargetId target_id,
             Profit profit);
 
+    /** Set the profit of all targets to 1. */
+    void set_unicost();
+
+    /**
+     * Also store the observables of each night as a structure of arrays.
+     *
+     * This duplicates the observables of the instance, so it is disabled by
+     * default. See 'Instance::night_observables'.
+     */
+    void set_night_observables(bool night_observables) { night_observables_ = night_observables; }
+
+    /**
+     * Enable the reduction of the instance applied when building it.
+     *
+     * The reduction removes the observables whose observation time doesn't
+     * fit in their time window and the targets whose profit is not
+     * positive. It also removes the observables dominated by another
+     * observable of the same target during the same night, that is, whose
+     * time window is contained in the time window of the other one and
+     * whose observation time is not shorter. Then, while a target has an
+     * observable whose time window doesn't intersect the time window of any
+     * other observable of its night, the target is fixed: it is observed at the start of this time
+     * window, and all its observables are removed. Targets without
+     * remaining observable are removed.
+     *
+     * The reduction is exact. The ids of the targets and of the observables
+     * of the built instance are the ids after the reduction; solutions are
+     * written with the original ids and include the fixed observations.
+     */
+    void set_reduction(bool reduction) { reduction_ = reduction; }
+
     /** Read an instance from a file. */
     void read(
             const std::string& instance_path,
@@ -60,6 +91,9 @@ private:
     /** Read an instance file in 'catusse2016' format. */
     void read_catusse2016(std::ifstream& file);
 
+    /** Reduce the instance. */
+    void reduce();
+
     /*
      * Private attributes
      */
@@ -67,6 +101,12 @@ private:
     /** Instance. */
     Instance instance_;
 
+    /** 'true' iff the instance is reduced when it is built. */
+    bool reduction_ = false;
+
+    /** 'true' iff the observables of the nights are stored as structures of arrays. */
+    bool night_observables_ = false;
+
 };
 
 }
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "starobservationschedulingsolver/utils/types.hpp"
+#include "starobservationschedulingsolver/utils/target_clones.hpp"
+
+#include <cstdint>
+#include <algorithm>
+
+namespace starobservationschedulingsolver
+{
+
+/**
+ * Extend a front indexed by number of observations with an observation.
+ *
+ * When all observations have the same profit, the Pareto front of the (end
+ * time, profit) pairs of the schedules is indexed by their number of
+ * observations: 'times[k]' is the earliest end time of a schedule of 'k'
+ * observations, and these times are non-decreasing.
+ *
+ * An observation starting after time 'release_date' and lasting
+ * 'observation_time' is appended to the schedules of 0 to 'last_count'
+ * observations. 'extended_times[k + 1]' is set to the best of 'times[k + 1]'
+ * and of the end of the extended schedule of 'k' observations, and
+ * 'decisions[k]' to 1 if the extended schedule is better, 0 otherwise. The
+ * caller selects 'last_count' so that all the extended schedules meet the
+ * deadline, and 'times[last_count + 1]' must exist.
+ *
+ * This loop has no dependency between iterations and no branch, so it is
+ * vectorized; a version is compiled for each of AVX-512, AVX2 and the
+ * default instruction set.
+ */
+STAROBSERVATIONSCHEDULINGSOLVER_TARGET_CLONES
+inline void extend_counts(
+        const TimeType* __restrict times,
+        int64_t last_count,
+        TimeType release_date,
+        TimeType observation_time,
+        TimeType* __restrict extended_times,
+        uint8_t* __restrict decisions)
+{
+    for (int64_t count = 0; count <= last_count; ++count) {
+        TimeType end = (std::max)(times[count], release_date) + observation_time;
+        bool improves = end < times[count + 1];
+        extended_times[count + 1] = improves? end: times[count + 1];
+        decisions[count] = improves;
+    }
+}
+
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+
+namespace starobservationschedulingsolver
+{
+
+/**
+ * Split the targets of a night into independent segments.
+ *
+ * The targets are considered in the meridian order, and for equal meridians,
+ * in the order of their ids, as in the single night dynamic programs. A new
+ * segment starts before a target if the deadlines of all the previous
+ * targets are not after the earliest starts of all the next ones. Since the
+ * telescope is free from time 0, the earliest start of a target is
+ * 'max(0, release_date)'. Then no schedule carries time across the gap, and
+ * the best schedule of the night is the concatenation of the best schedules
+ * of its segments, in the segment order.
+ *
+ * Targets whose time window is shorter than their observation time can't be
+ * observed; they don't prevent a gap and stay in the current segment.
+ *
+ * Return the number of segments and fill 'segment_ids' with the segment of
+ * each target. The segments are numbered in the meridian order.
+ */
+template <typename Time>
+int64_t compute_night_segments(
+        const std::vector<Time>& release_dates,
+        const std::vector<Time>& meridians,
+        const std::vector<Time>& deadlines,
+        const std::vector<Time>& observation_times,
+        std::vector<int64_t>& segment_ids)
+{
+    int64_t number_of_targets = meridians.size();
+    segment_ids.assign(number_of_targets, 0);
+    if (number_of_targets == 0)
+        return 0;
+
+    std::vector<int64_t> order(number_of_targets);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(
+            order.begin(),
+            order.end(),
+            [&meridians](int64_t target_id_1, int64_t target_id_2)
+            {
+                return meridians[target_id_1] < meridians[target_id_2];
+            });
+
+    auto earliest_start = [&release_dates](int64_t target_id)
+    {
+        return (std::max)((Time)0, release_dates[target_id]);
+    };
+    auto feasible = [&deadlines, &observation_times, &earliest_start](int64_t target_id)
+    {
+        return deadlines[target_id] - earliest_start(target_id)
+            >= observation_times[target_id];
+    };
+
+    // Earliest start of the feasible targets from each position, and number
+    // of these targets.
+    std::vector<Time> suffix_starts(number_of_targets + 1, std::numeric_limits<Time>::max());
+    std::vector<int64_t> suffix_sizes(number_of_targets + 1, 0);
+    for (int64_t pos = number_of_targets - 1; pos >= 0; --pos) {
+        int64_t target_id = order[pos];
+        suffix_starts[pos] = suffix_starts[pos + 1];
+        suffix_sizes[pos] = suffix_sizes[pos + 1];
+        if (feasible(target_id)) {
+            suffix_starts[pos] = (std::min)(suffix_starts[pos], earliest_start(target_id));
+            suffix_sizes[pos]++;
+        }
+    }
+
+    // A segment is only closed once it contains a feasible target and if a
+    // feasible target remains after it.
+    int64_t segment_id = 0;
+    bool segment_feasible = false;
+    Time latest_deadline = std::numeric_limits<Time>::min();
+    for (int64_t pos = 0; pos < number_of_targets; ++pos) {
+        int64_t target_id = order[pos];
+        if (segment_feasible
+                && suffix_sizes[pos] > 0
+                && latest_deadline <= suffix_starts[pos]) {
+            segment_id++;
+            segment_feasible = false;
+        }
+        segment_ids[target_id] = segment_id;
+        if (feasible(target_id)) {
+            segment_feasible = true;
+            latest_deadline = (std::max)(latest_deadline, deadlines[target_id]);
+        }
+    }
+    return segment_id + 1;
+}
+
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "starobservationschedulingsolver/utils/span.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <algorithm>
+
+namespace starobservationschedulingsolver
+{
+
+/**
+ * Reduction of the observation times of the targets of a flexible instance.
+ *
+ * - 'None': all observation times are kept.
+ * - 'Dominance': an observation time is removed if another observation time
+ *   of the same target is not longer and at least as profitable, or if its
+ *   profit is not positive. An observation which contains the meridian can
+ *   always be shortened to a shorter observation time which still contains
+ *   it, so this reduction is exact.
+ * - 'ConcaveHull': after the dominance reduction, only the observation
+ *   times on the upper concave hull of the (observation time, profit)
+ *   points are kept. This is a heuristic reduction: an optimal solution of
+ *   the reduced instance might not be optimal for the original instance.
+ */
+enum class ObservationTimeReduction
+{
+    None,
+    Dominance,
+    ConcaveHull,
+};
+
+inline std::istream& operator>>(
+        std::istream& in,
+        ObservationTimeReduction& reduction)
+{
+    std::string token;
+    in >> token;
+    if (token == "none") {
+        reduction = ObservationTimeReduction::None;
+    } else if (token == "dominance") {
+        reduction = ObservationTimeReduction::Dominance;
+    } else if (token == "concave-hull") {
+        reduction = ObservationTimeReduction::ConcaveHull;
+    } else  {
+        in.setstate(std::ios_base::failbit);
+    }
+    return in;
+}
+
+inline std::ostream& operator<<(
+        std::ostream& os,
+        ObservationTimeReduction reduction)
+{
+    switch (reduction) {
+    case ObservationTimeReduction::None: {
+        os << "none";
+        break;
+    } case ObservationTimeReduction::Dominance: {
+        os << "dominance";
+        break;
+    } case ObservationTimeReduction::ConcaveHull: {
+        os << "concave-hull";
+        break;
+    }
+    }
+    return os;
+}
+
+/**
+ * Reduce the observation times of a target.
+ *
+ * Return the positions of the kept observation times, sorted by increasing
+ * observation time. With the 'Dominance' and 'ConcaveHull' reductions, the
+ * profits of the kept observation times are also increasing.
+ */
+template <typename Time, typename Profit>
+std::vector<int64_t> reduce_observation_times(
+        Span<Time> observation_times,
+        Span<Profit> profits,
+        ObservationTimeReduction reduction)
+{
+    std::vector<int64_t> positions(observation_times.size());
+    for (int64_t pos = 0; pos < (int64_t)positions.size(); ++pos)
+        positions[pos] = pos;
+    if (reduction == ObservationTimeReduction::None)
+        return positions;
+
+    // Sort the observation times by increasing duration and, for equal
+    // durations, by decreasing profit.
+    std::sort(
+            positions.begin(),
+            positions.end(),
+            [&observation_times, &profits](int64_t pos_1, int64_t pos_2)
+            {
+                if (observation_times[pos_1] != observation_times[pos_2])
+                    return observation_times[pos_1] < observation_times[pos_2];
+                if (profits[pos_1] != profits[pos_2])
+                    return profits[pos_1] > profits[pos_2];
+                return pos_1 < pos_2;
+            });
+
+    // Remove dominated observation times. Not observing the target is an
+    // option of duration 0 and profit 0.
+    std::vector<int64_t> kept_positions;
+    Profit best_profit = 0;
+    for (int64_t pos: positions) {
+        if (profits[pos] <= best_profit)
+            continue;
+        kept_positions.push_back(pos);
+        best_profit = profits[pos];
+    }
+    if (reduction == ObservationTimeReduction::Dominance)
+        return kept_positions;
+
+    // Keep the upper concave hull. The observation times are increasing, so
+    // an observation time is removed if it is not strictly above the segment
+    // between its neighbors on the hull.
+    std::vector<int64_t> hull;
+    for (int64_t pos: kept_positions) {
+        while (hull.size() >= 2) {
+            int64_t pos_1 = hull[hull.size() - 2];
+            int64_t pos_2 = hull[hull.size() - 1];
+            double cross
+                = (double)(observation_times[pos_2] - observation_times[pos_1])
+                * (profits[pos] - profits[pos_1])
+                - (profits[pos_2] - profits[pos_1])
+                * (double)(observation_times[pos] - observation_times[pos_1]);
+            if (cross < 0)
+                break;
+            hull.pop_back();
+        }
+        hull.push_back(pos);
+    }
+    return hull;
+}
+
+}
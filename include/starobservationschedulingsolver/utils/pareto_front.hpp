@@ -0,0 +1,307 @@
+#pragma once
+
+#include "starobservationschedulingsolver/utils/types.hpp"
+#include "starobservationschedulingsolver/utils/target_clones.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+
+namespace starobservationschedulingsolver
+{
+
+/**
+ * States of a dynamic program over Pareto fronts of (time, profit) pairs.
+ *
+ * The states are stored as a structure of arrays so that the times of a
+ * front are contiguous. Each state has the index of its previous state and a
+ * label identifying its last observation.
+ *
+ * The arrays may be larger than the number of states; the states are the
+ * first 'size' elements.
+ */
+struct ParetoStates
+{
+    /** Times. */
+    std::vector<TimeType> times;
+
+    /** Profits. */
+    std::vector<double> profits;
+
+    /** Indices of the previous states; -1 for the root state. */
+    std::vector<int32_t> prevs;
+
+    /** Labels of the last observations; -1 for the root state. */
+    std::vector<int32_t> labels;
+
+    /** Number of states. */
+    int64_t size = 0;
+
+
+    /** Make room for 'number_of_states' states. */
+    void reserve(int64_t number_of_states)
+    {
+        if ((int64_t)times.size() >= number_of_states)
+            return;
+        int64_t capacity = (std::max)(number_of_states, (int64_t)(2 * times.size()));
+        times.resize(capacity);
+        profits.resize(capacity);
+        prevs.resize(capacity);
+        labels.resize(capacity);
+    }
+
+    /** Add a state. */
+    void push_back(
+            TimeType time,
+            double profit,
+            int32_t prev,
+            int32_t label)
+    {
+        reserve(size + 1);
+        times[size] = time;
+        profits[size] = profit;
+        prevs[size] = prev;
+        labels[size] = label;
+        size++;
+    }
+};
+
+/**
+ * Compute the end times of the states of a front extended with an
+ * observation.
+ *
+ * An observation starting after time 'release_date' and lasting
+ * 'observation_time' is appended to each state. Since the times of the front
+ * are increasing, the extended states which start before 'latest_time' and
+ * end before 'deadline' form a prefix of the front; the length of this
+ * prefix is returned.
+ *
+ * This loop has no dependency between iterations, so it is vectorized; a
+ * version is compiled for each of AVX-512, AVX2 and the default instruction
+ * set, see 'STAROBSERVATIONSCHEDULINGSOLVER_TARGET_CLONES'. Since the
+ * function is inline, each translation unit using it has its own versions
+ * and dispatch.
+ */
+STAROBSERVATIONSCHEDULINGSOLVER_TARGET_CLONES
+inline int64_t extend_times(
+        const TimeType* times,
+        int64_t number_of_states,
+        TimeType release_date,
+        TimeType observation_time,
+        TimeType latest_time,
+        TimeType deadline,
+        TimeType* extended_times)
+{
+    int64_t number_of_valid_states = 0;
+    for (int64_t state_pos = 0; state_pos < number_of_states; ++state_pos) {
+        TimeType time = times[state_pos];
+        TimeType end = (std::max)(time, release_date) + observation_time;
+        extended_times[state_pos] = end;
+        number_of_valid_states += (time <= latest_time) & (end <= deadline);
+    }
+    return number_of_valid_states;
+}
+
+/**
+ * Merge a front with an extended front and append the non-dominated states
+ * at the end of 'destination'.
+ *
+ * The states of the first front are the states 'skip_start' to 'skip_end' of
+ * 'skip_source'. The states of the extended front are the states
+ * 'take_start' to 'take_start + number_of_take_states' of 'take_source',
+ * with times 'take_times' and with profit 'profit' and label 'label' added.
+ *
+ * The sources may be 'destination' itself.
+ *
+ * The fronts and the result are sorted by strictly increasing time and
+ * strictly increasing profit. The comparisons are turned into conditional
+ * moves: each iteration writes the current state after the last kept one and
+ * only advances the end of the result if the state is kept.
+ *
+ * Only the states of the first front within the time range of the extended
+ * front are compared: the ones before are copied as they are, and the ones
+ * after are copied from the first one which is not dominated. Thus, a merge
+ * with an extended front spanning a small part of the night costs little
+ * more than a copy.
+ *
+ * The merge is scalar: each state depends on the last kept one. Only the
+ * extension pass, 'extend_times', is vectorized.
+ *
+ * Return the start of the result in 'destination'.
+ */
+inline int64_t merge_fronts(
+        const ParetoStates& skip_source,
+        int64_t skip_start,
+        int64_t skip_end,
+        const ParetoStates& take_source,
+        int64_t take_start,
+        const TimeType* take_times,
+        int64_t number_of_take_states,
+        double profit,
+        int32_t label,
+        ParetoStates& destination)
+{
+    // Reserve the space before getting the pointers since the sources may be
+    // the destination. One more state is needed for the writes of dominated
+    // states.
+    int64_t start = destination.size;
+    destination.reserve(start + (skip_end - skip_start) + number_of_take_states + 1);
+
+    const TimeType* skip_times = skip_source.times.data();
+    const double* skip_profits = skip_source.profits.data();
+    const int32_t* skip_prevs = skip_source.prevs.data();
+    const int32_t* skip_labels = skip_source.labels.data();
+    const double* take_profits = take_source.profits.data() + take_start;
+    TimeType* times = destination.times.data();
+    double* profits = destination.profits.data();
+    int32_t* prevs = destination.prevs.data();
+    int32_t* labels = destination.labels.data();
+
+    int64_t end = start;
+    TimeType last_time = 0;
+    double last_profit = -std::numeric_limits<double>::infinity();
+    auto add = [&](TimeType time, double state_profit, int32_t prev, int32_t state_label)
+    {
+        // A state is kept if its profit is greater than the profit of the
+        // last kept state. It replaces it if they have the same time.
+        bool keep = state_profit > last_profit;
+        bool replace = keep & (end != start) & (time == last_time);
+        int64_t pos = end - replace;
+        times[pos] = time;
+        profits[pos] = state_profit;
+        prevs[pos] = prev;
+        labels[pos] = state_label;
+        end = pos + keep;
+        last_time = keep? time: last_time;
+        last_profit = keep? state_profit: last_profit;
+    };
+
+    // Copy states of the first front which are kept as they are.
+    auto copy = [&](int64_t copy_start, int64_t copy_end)
+    {
+        if (copy_start == copy_end)
+            return;
+        std::copy(skip_times + copy_start, skip_times + copy_end, times + end);
+        std::copy(skip_profits + copy_start, skip_profits + copy_end, profits + end);
+        std::copy(skip_prevs + copy_start, skip_prevs + copy_end, prevs + end);
+        std::copy(skip_labels + copy_start, skip_labels + copy_end, labels + end);
+        end += copy_end - copy_start;
+        last_time = times[end - 1];
+        last_profit = profits[end - 1];
+    };
+
+    // The states of the first front which end before the first state of the
+    // extended front are kept.
+    int64_t skip_pos = skip_start;
+    int64_t take_pos = 0;
+    if (number_of_take_states > 0) {
+        skip_pos = std::lower_bound(
+                skip_times + skip_start,
+                skip_times + skip_end,
+                take_times[0]) - skip_times;
+        copy(skip_start, skip_pos);
+    }
+
+    while (skip_pos < skip_end && take_pos < number_of_take_states) {
+        bool take = take_times[take_pos] < skip_times[skip_pos];
+        add(
+                take? take_times[take_pos]: skip_times[skip_pos],
+                take? take_profits[take_pos] + profit: skip_profits[skip_pos],
+                take? (int32_t)(take_start + take_pos): skip_prevs[skip_pos],
+                take? label: skip_labels[skip_pos]);
+        take_pos += take;
+        skip_pos += !take;
+    }
+
+    // Once the extended front is exhausted, the states of the first front
+    // are kept from the first one whose profit is greater than the profit of
+    // the last kept state. This one may replace the last kept state.
+    skip_pos = std::upper_bound(
+            skip_profits + skip_pos,
+            skip_profits + skip_end,
+            last_profit) - skip_profits;
+    if (skip_pos < skip_end) {
+        add(
+                skip_times[skip_pos],
+                skip_profits[skip_pos],
+                skip_prevs[skip_pos],
+                skip_labels[skip_pos]);
+        copy(skip_pos + 1, skip_end);
+    }
+    for (; take_pos < number_of_take_states; ++take_pos) {
+        add(
+                take_times[take_pos],
+                take_profits[take_pos] + profit,
+                (int32_t)(take_start + take_pos),
+                label);
+    }
+
+    destination.size = end;
+    return start;
+}
+
+/**
+ * Remove the states of a front whose profit is close to the profit of an
+ * earlier state.
+ *
+ * The states of the front are the states from 'start' to the end of
+ * 'states', sorted by increasing time and profit. A state is removed if its
+ * profit is at most 'factor' times the profit of the last kept state. The
+ * last kept state ends earlier, so any extension of a removed state is also
+ * an extension of the kept one, whose profit is at least the profit of the
+ * extension of the removed state divided by 'factor'.
+ *
+ * If more than 'maximum_number_of_states' states would be kept, the factor
+ * is increased so that they fit: with a factor f, the kept states of
+ * positive profit between p_min and p_max are fewer than
+ * 1 + log(p_max / p_min) / log(f). 'maximum_number_of_states' must be at
+ * least 3.
+ *
+ * Return the largest ratio between the profit of a removed state and the
+ * profit of the state kept in its place; 1 if no state is removed.
+ */
+inline double trim_front(
+        ParetoStates& states,
+        int64_t start,
+        double factor,
+        int64_t maximum_number_of_states)
+{
+    int64_t number_of_states = states.size - start;
+    if (number_of_states > maximum_number_of_states) {
+        // Only the first state may have a profit of 0.
+        double profit_min = (states.profits[start] > 0)?
+            states.profits[start]:
+            states.profits[start + 1];
+        double profit_max = states.profits[states.size - 1];
+        factor = (std::max)(
+                factor,
+                std::pow(
+                    profit_max / profit_min,
+                    1.0 / (double)(maximum_number_of_states - 2)));
+    }
+    if (factor <= 1 || number_of_states <= 1)
+        return 1;
+
+    double ratio = 1;
+    int64_t end = start + 1;
+    double last_profit = states.profits[start];
+    for (int64_t state_id = start + 1; state_id < states.size; ++state_id) {
+        double profit = states.profits[state_id];
+        if (profit <= factor * last_profit) {
+            ratio = (std::max)(ratio, profit / last_profit);
+            continue;
+        }
+        states.times[end] = states.times[state_id];
+        states.profits[end] = profit;
+        states.prevs[end] = states.prevs[state_id];
+        states.labels[end] = states.labels[state_id];
+        last_profit = profit;
+        end++;
+    }
+    states.size = end;
+    return ratio;
+}
+
+}
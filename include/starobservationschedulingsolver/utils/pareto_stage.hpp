@@ -0,0 +1,139 @@
+#pragma once
+
+#include "starobservationschedulingsolver/utils/pareto_front.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+namespace starobservationschedulingsolver
+{
+
+/**
+ * Structure for an option of a target in a dynamic program over Pareto
+ * fronts.
+ *
+ * Choosing the option appends to a schedule an observation starting after
+ * 'release_date' and not after 'latest_start', lasting 'observation_time'
+ * and ending before 'deadline'.
+ */
+struct ParetoOption
+{
+    /** Earliest start of the observation. */
+    TimeType release_date;
+
+    /** Latest start of the observation. */
+    TimeType latest_start;
+
+    /** Latest end of the observation. */
+    TimeType deadline;
+
+    /** Observation time. */
+    TimeType observation_time;
+
+    /** Profit of the observation; must be positive. */
+    double profit;
+
+    /** Label of the states ending with the observation. */
+    int32_t label;
+};
+
+/** Buffers of 'compute_pareto_stage', kept between calls. */
+struct ParetoStageBuffers
+{
+    /** End times of the states extended with an option. */
+    std::vector<TimeType> extended_times;
+
+    /** Fronts after considering only some of the options of a target. */
+    ParetoStates fronts[2];
+};
+
+/**
+ * Compute the states of the next stage of a dynamic program over Pareto
+ * fronts at the end of 'destination' and return the start of the next stage.
+ *
+ * The states of the next stage are the states of the current stage and the
+ * states of the current stage extended with each option of the current
+ * target. The states of the current stage are the states 'stage_start' to
+ * 'stage_end' of 'states'; 'destination' may be 'states'. The target must
+ * have at least one option.
+ *
+ * The options are a container of 'ParetoOption' with 'size' and
+ * 'operator[]'. The number of options is known at compile time with a
+ * 'std::array': with 'std::array<ParetoOption, 1>', for a target with a
+ * single observation time, the loop over the options and the intermediate
+ * fronts are removed. With a 'Span<ParetoOption>', the number of options is
+ * variable. In both cases, each option is merged in a single pass with the
+ * front of the options before it; only the last merge writes into
+ * 'destination'.
+ *
+ * Only the states which lead to distinct feasible extensions are extended:
+ * all the states ending before the release date of an option lead to the
+ * same end time, so only the last one of them, which has the best profit,
+ * is extended; and the states ending after the latest feasible start of the
+ * option can't be extended. Both limits are found by binary search. For a
+ * rigid option, whose latest feasible start is its release date, at most
+ * one state is extended.
+ */
+template <typename Options>
+int64_t compute_pareto_stage(
+        const ParetoStates& states,
+        int64_t stage_start,
+        int64_t stage_end,
+        const Options& options,
+        ParetoStageBuffers& buffers,
+        ParetoStates& destination)
+{
+    int64_t stage_size = stage_end - stage_start;
+    if ((int64_t)buffers.extended_times.size() < stage_size)
+        buffers.extended_times.resize(stage_size);
+    const TimeType* times = states.times.data();
+    const ParetoStates* skip_source = &states;
+    int64_t skip_start = stage_start;
+    int64_t skip_end = stage_end;
+    int64_t number_of_options = options.size();
+    for (int64_t option_pos = 0; option_pos < number_of_options; ++option_pos) {
+        const ParetoOption& option = options[option_pos];
+        TimeType latest_start = (std::min)(
+                option.latest_start,
+                (TimeType)(option.deadline - option.observation_time));
+        int64_t extension_start = std::upper_bound(
+                times + stage_start,
+                times + stage_end,
+                option.release_date) - times;
+        if (extension_start > stage_start)
+            extension_start--;
+        int64_t extension_end = std::upper_bound(
+                times + extension_start,
+                times + stage_end,
+                latest_start) - times;
+        int64_t number_of_extended_states = extend_times(
+                times + extension_start,
+                extension_end - extension_start,
+                option.release_date,
+                option.observation_time,
+                option.latest_start,
+                option.deadline,
+                buffers.extended_times.data());
+        ParetoStates& option_destination = (option_pos == number_of_options - 1)?
+            destination: buffers.fronts[option_pos % 2];
+        if (&option_destination != &destination)
+            option_destination.size = 0;
+        skip_start = merge_fronts(
+                *skip_source,
+                skip_start,
+                skip_end,
+                states,
+                extension_start,
+                buffers.extended_times.data(),
+                number_of_extended_states,
+                option.profit,
+                option.label,
+                option_destination);
+        skip_source = &option_destination;
+        skip_end = option_destination.size;
+    }
+    return skip_start;
+}
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace starobservationschedulingsolver
+{
+
+/**
+ * Read-only view of contiguous elements.
+ *
+ * The elements are owned by another container, typically the flat arrays of
+ * an instance, which must outlive the view.
+ */
+template <typename T>
+class Span
+{
+
+public:
+
+    /** Constructor. */
+    Span() { }
+
+    /** Constructor. */
+    Span(const T* data, int64_t size): data_(data), size_(size) { }
+
+    /** Constructor from a vector. */
+    Span(const std::vector<T>& vector): data_(vector.data()), size_(vector.size()) { }
+
+    /** Get the number of elements. */
+    inline int64_t size() const { return size_; }
+
+    /** Return 'true' iff the view has no element. */
+    inline bool empty() const { return size_ == 0; }
+
+    /** Get the elements. */
+    inline const T* data() const { return data_; }
+
+    /** Get an element. */
+    inline const T& operator[](int64_t pos) const { return data_[pos]; }
+
+    inline const T* begin() const { return data_; }
+
+    inline const T* end() const { return data_ + size_; }
+
+private:
+
+    /** Elements. */
+    const T* data_ = nullptr;
+
+    /** Number of elements. */
+    int64_t size_ = 0;
+
+};
+
+}
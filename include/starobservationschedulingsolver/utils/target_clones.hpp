@@ -0,0 +1,14 @@
+#pragma once
+
+/**
+ * Generate several versions of a function for different instruction sets
+ * and select the best one for the current CPU at load time.
+ *
+ * This relies on GNU indirect functions, so it is only enabled with GCC on
+ * x86-64 Linux.
+ */
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__)
+#define STAROBSERVATIONSCHEDULINGSOLVER_TARGET_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define STAROBSERVATIONSCHEDULINGSOLVER_TARGET_CLONES
+#endif
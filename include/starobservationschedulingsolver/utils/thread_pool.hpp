@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+
+namespace starobservationschedulingsolver
+{
+
+/**
+ * Thread pool running batches of independent tasks.
+ *
+ * The threads are created once and reused for all batches. Tasks are not
+ * assigned statically to the threads: each thread repeatedly takes the next
+ * task not yet started, so that a thread which finishes early keeps working
+ * while the others are busy with longer tasks. The calling thread also
+ * processes tasks.
+ */
+class ThreadPool
+{
+
+public:
+
+    /** Constructor. */
+    ThreadPool(int64_t number_of_threads)
+    {
+        for (int64_t thread_id = 1; thread_id < number_of_threads; ++thread_id)
+            threads_.push_back(std::thread(&ThreadPool::work, this));
+    }
+
+    /** Destructor. */
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        start_condition_.notify_all();
+        for (std::thread& thread: threads_)
+            thread.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /** Get the number of threads, including the calling thread. */
+    int64_t number_of_threads() const { return threads_.size() + 1; }
+
+    /**
+     * Call 'task(task_id)' for each task_id in [0, number_of_tasks) and wait
+     * until all tasks are done.
+     *
+     * If a task throws, the first exception is rethrown once all running
+     * tasks are done.
+     */
+    void run(
+            int64_t number_of_tasks,
+            const std::function<void(int64_t)>& task)
+    {
+        if (threads_.empty()) {
+            for (int64_t task_id = 0; task_id < number_of_tasks; ++task_id)
+                task(task_id);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &task;
+            number_of_tasks_ = number_of_tasks;
+            next_task_ = 0;
+            number_of_running_threads_ = threads_.size();
+            exception_ = nullptr;
+            batch_++;
+        }
+        start_condition_.notify_all();
+
+        process_tasks();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        end_condition_.wait(lock, [this] { return number_of_running_threads_ == 0; });
+        task_ = nullptr;
+        if (exception_ != nullptr)
+            std::rethrow_exception(exception_);
+    }
+
+private:
+
+    /** Process tasks until all tasks of the current batch have started. */
+    void process_tasks()
+    {
+        for (;;) {
+            int64_t task_id = next_task_++;
+            if (task_id >= number_of_tasks_)
+                break;
+            try {
+                (*task_)(task_id);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (exception_ == nullptr)
+                    exception_ = std::current_exception();
+            }
+        }
+    }
+
+    /** Main loop of the threads of the pool. */
+    void work()
+    {
+        int64_t batch = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                start_condition_.wait(lock, [this, batch] { return stop_ || batch_ != batch; });
+                if (stop_)
+                    return;
+                batch = batch_;
+            }
+
+            process_tasks();
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                number_of_running_threads_--;
+            }
+            end_condition_.notify_one();
+        }
+    }
+
+    /*
+     * Private attributes
+     */
+
+    /** Threads. */
+    std::vector<std::thread> threads_;
+
+    /** Mutex. */
+    std::mutex mutex_;
+
+    /** Condition variable notified when a batch starts or the pool stops. */
+    std::condition_variable start_condition_;
+
+    /** Condition variable notified when a thread has finished its batch. */
+    std::condition_variable end_condition_;
+
+    /** Task of the current batch. */
+    const std::function<void(int64_t)>* task_ = nullptr;
+
+    /** Number of tasks of the current batch. */
+    int64_t number_of_tasks_ = 0;
+
+    /** Next task to start. */
+    std::atomic<int64_t> next_task_{0};
+
+    /** Number of threads of the pool still working on the current batch. */
+    int64_t number_of_running_threads_ = 0;
+
+    /** Id of the current batch. */
+    int64_t batch_ = 0;
+
+    /** Exception thrown by a task of the current batch. */
+    std::exception_ptr exception_ = nullptr;
+
+    /** 'true' iff the pool is being destroyed. */
+    bool stop_ = false;
+
+};
+
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "starobservationschedulingsolver/utils/target_clones.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+namespace starobservationschedulingsolver
+{
+
+/**
+ * Extend the values of a time-indexed dynamic program with an observation.
+ *
+ * 'values[t]' is the best profit of a schedule for which the telescope is
+ * free at time 't'. For each end time 't' between 'first_end' and
+ * 'last_end', the observation ending at time 't' is appended to the best
+ * schedule for which the telescope is free at time 't - observation_time'.
+ * If this improves 'extended_values[t]', it is updated and
+ * 'decisions[t - first_end]' is set to 'decision'.
+ *
+ * 'values' and 'extended_values' must not overlap. Then, this loop has no
+ * dependency between iterations, so it is vectorized; a version is compiled
+ * for each of AVX-512, AVX2 and the default instruction set.
+ */
+template <typename Time, typename Profit>
+STAROBSERVATIONSCHEDULINGSOLVER_TARGET_CLONES
+inline void extend_values(
+        const Profit* __restrict values,
+        Time first_end,
+        Time last_end,
+        Time observation_time,
+        Profit profit,
+        uint8_t decision,
+        Profit* __restrict extended_values,
+        uint8_t* __restrict decisions)
+{
+    for (Time time = first_end; time <= last_end; ++time) {
+        Profit value = values[time - observation_time] + profit;
+        bool improves = value > extended_values[time];
+        extended_values[time] = improves? value: extended_values[time];
+        decisions[time - first_end] = improves? decision: decisions[time - first_end];
+    }
+}
+
+/**
+ * Extend the values of a time-indexed dynamic program with an observation
+ * whose observation time belongs to an interval.
+ *
+ * Observing during observation time 'p' yields a profit of
+ * 'profit + profit_slope * (p - minimum_observation_time)'. For each end
+ * time 't' between 'first_end' and 'last_end', the observation may start at
+ * any time 's' between 'max(first_start, t - maximum_observation_time)' and
+ * 'min(last_start, t - minimum_observation_time)', and the best start time
+ * maximizes 'values[s] - profit_slope * s'. Both bounds are non-decreasing
+ * in 't', so the candidate start times are kept in a monotone queue and the
+ * cost is linear in the number of end times, whatever the length of the
+ * interval.
+ *
+ * If the best observation ending at time 't' improves 'extended_values[t]',
+ * it is updated, 'decisions[t - first_end]' is set to 'decision' and
+ * 'observation_times[t - first_end]' to the observation time. 'queue' is a
+ * buffer.
+ */
+template <typename Time, typename Profit>
+inline void extend_values_interval(
+        const Profit* values,
+        Time first_start,
+        Time last_start,
+        Time first_end,
+        Time last_end,
+        Time minimum_observation_time,
+        Time maximum_observation_time,
+        Profit profit,
+        Profit profit_slope,
+        uint8_t decision,
+        Profit* extended_values,
+        uint8_t* decisions,
+        Time* observation_times,
+        std::vector<Time>& queue)
+{
+    if (first_start > last_start)
+        return;
+    if ((int64_t)queue.size() < (int64_t)last_start - first_start + 1)
+        queue.resize(last_start - first_start + 1);
+    int64_t queue_begin = 0;
+    int64_t queue_end = 0;
+    Time next_start = first_start;
+    for (Time time = first_end; time <= last_end; ++time) {
+
+        // Add the start times which become possible.
+        Time upper_start = (std::min)(last_start, (Time)(time - minimum_observation_time));
+        for (; next_start <= upper_start; ++next_start) {
+            Profit key = values[next_start] - profit_slope * next_start;
+            while (queue_end > queue_begin
+                    && values[queue[queue_end - 1]] - profit_slope * queue[queue_end - 1] <= key) {
+                queue_end--;
+            }
+            queue[queue_end] = next_start;
+            queue_end++;
+        }
+
+        // Remove the start times which are not possible anymore.
+        Time lower_start = (std::max)(first_start, (Time)(time - maximum_observation_time));
+        while (queue_end > queue_begin && queue[queue_begin] < lower_start)
+            queue_begin++;
+        if (queue_end == queue_begin)
+            continue;
+
+        Time start = queue[queue_begin];
+        Time observation_time = time - start;
+        Profit value = values[start] + profit
+            + profit_slope * (observation_time - minimum_observation_time);
+        if (value > extended_values[time]) {
+            extended_values[time] = value;
+            decisions[time - first_end] = decision;
+            observation_times[time - first_end] = observation_time;
+        }
+    }
+}
+
+/**
+ * Update the values of a time-indexed dynamic program from extended values.
+ *
+ * The values of a stage are non-decreasing: a telescope free at some time
+ * is also free at any later time. 'values[t]' is set to the maximum of
+ * 'values[t - 1]' and 'extended_values[t]' for 't' between 'first_time' and
+ * 'last_time'. Then the maximum keeps being propagated to the next times,
+ * up to 'horizon', as long as it improves their values.
+ *
+ * The decisions of the times from 'first_time' are stored in 'decisions'
+ * starting at 'decisions_start'. The decisions of the times up to
+ * 'last_time' must already be there, at the end of 'decisions'; the ones of
+ * the later updated times are appended. Decision 0 means that the value
+ * comes from the previous time.
+ *
+ * Return the last updated time.
+ */
+template <typename Time, typename Profit>
+inline Time propagate_values(
+        Profit* values,
+        Time horizon,
+        const Profit* extended_values,
+        Time first_time,
+        Time last_time,
+        std::vector<uint8_t>& decisions,
+        int64_t decisions_start)
+{
+    Profit value_prev = (first_time > 0)?
+        values[first_time - 1]:
+        std::numeric_limits<Profit>::lowest();
+    for (Time time = first_time; time <= last_time; ++time) {
+        bool idle = value_prev > extended_values[time];
+        value_prev = idle? value_prev: extended_values[time];
+        values[time] = value_prev;
+        if (idle)
+            decisions[decisions_start + time - first_time] = 0;
+    }
+    Time time = last_time + 1;
+    for (; time <= horizon && value_prev > values[time]; ++time) {
+        values[time] = value_prev;
+        decisions.push_back(0);
+    }
+    return time - 1;
+}
+
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Numeric types shared by all the problems.
+ *
+ * By default, times and ids are 64-bit integers. If
+ * 'STAROBSERVATIONSCHEDULINGSOLVER_COMPACT_TYPES' is defined, they are
+ * 32-bit integers, which halves the size of the observables, of the
+ * observations and of the dynamic programming states. The times of a night
+ * and the number of targets of the instances always fit.
+ *
+ * If 'STAROBSERVATIONSCHEDULINGSOLVER_INTEGER_PROFITS' is defined, the
+ * profits of the targets of the 'star_observation_scheduling' problem are
+ * integers, so that the profit of a solution is computed exactly. The
+ * profits of the other problems stay floating-point: the single-night
+ * problem is the pricing problem of the column generation, whose profits are
+ * reduced costs, and the profits of the flexible problems are proportional
+ * to the observation times.
+ *
+ * These macros are set by the CMake options of the same names.
+ */
+
+namespace starobservationschedulingsolver
+{
+
+#ifdef STAROBSERVATIONSCHEDULINGSOLVER_COMPACT_TYPES
+using TimeType = int32_t;
+using IdType = int32_t;
+#else
+using TimeType = int64_t;
+using IdType = int64_t;
+#endif
+
+#ifdef STAROBSERVATIONSCHEDULINGSOLVER_INTEGER_PROFITS
+using IntegerProfitType = int64_t;
+#else
+using IntegerProfitType = double;
+#endif
+
+}
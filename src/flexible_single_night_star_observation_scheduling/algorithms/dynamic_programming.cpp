@@ -2,30 +2,452 @@
 
 #include "starobservationschedulingsolver/flexible_single_night_star_observation_scheduling/algorithm_formatter.hpp"
 
+#include "starobservationschedulingsolver/utils/pareto_stage.hpp"
+#include "starobservationschedulingsolver/utils/time_indexed.hpp"
+#include "starobservationschedulingsolver/utils/span.hpp"
+
 using namespace starobservationschedulingsolver::flexible_single_night_star_observation_scheduling;
 
 namespace
 {
 
-struct DynamicProgrammingState
+/**
+ * Solve the problem with the Pareto engine and return the guarantee of the
+ * solution.
+ */
+double dynamic_programming_pareto(
+        const Instance& instance,
+        const std::vector<TargetId>& sorted_targets,
+        const DynamicProgrammingOptionalParameters& parameters,
+        Solution& solution)
 {
-    Time time;
-    Profit profit;
-    TargetId target_id;
-    Counter observation_time_pos;
-    DynamicProgrammingState* prev;
-};
-
-/*
-inline std::ostream& operator<<(
+    // Labels of the observations.
+    // The label of an observation is its index among all the pairs (target,
+    // observation time). The observation time intervals are expanded into
+    // one label per observation time. The labels of target 'target_id' are
+    // the ones between 'first_labels[target_id]' and
+    // 'first_labels[target_id + 1]'.
+    std::vector<TargetId> label_targets;
+    std::vector<Counter> label_observation_time_positions;
+    std::vector<Time> label_observation_times;
+    std::vector<Profit> label_profits;
+    std::vector<int32_t> first_labels(instance.number_of_targets() + 1);
+    for (TargetId target_id = 0;
+            target_id < instance.number_of_targets();
+            ++target_id) {
+        const Target& target = instance.target(target_id);
+        starobservationschedulingsolver::Span<Time> observation_times = instance.observation_times(target_id);
+        starobservationschedulingsolver::Span<Profit> profits = instance.profits(target_id);
+        starobservationschedulingsolver::Span<ObservationTimeInterval> observation_time_intervals = instance.observation_time_intervals(target_id);
+        first_labels[target_id] = label_targets.size();
+        for (Counter observation_time_pos = 0;
+                observation_time_pos < target.number_of_observation_times;
+                ++observation_time_pos) {
+            label_targets.push_back(target_id);
+            label_observation_time_positions.push_back(observation_time_pos);
+            label_observation_times.push_back(observation_times[observation_time_pos]);
+            label_profits.push_back(profits[observation_time_pos]);
+        }
+        for (Counter interval_pos = 0;
+                interval_pos < target.number_of_observation_time_intervals;
+                ++interval_pos) {
+            const ObservationTimeInterval& interval = observation_time_intervals[interval_pos];
+            for (Time observation_time = interval.minimum_observation_time;
+                    observation_time <= interval.maximum_observation_time;
+                    ++observation_time) {
+                label_targets.push_back(target_id);
+                label_observation_time_positions.push_back(target.number_of_observation_times + interval_pos);
+                label_observation_times.push_back(observation_time);
+                label_profits.push_back(interval.observation_time_profit(observation_time));
+            }
+        }
+    }
+    first_labels[instance.number_of_targets()] = label_targets.size();
+
+    // Compute the factor and the maximum number of states of the stages.
+    // The factors of the stages along a schedule multiply, so the factor of
+    // a stage is the n-th root of the factor allowed by 'epsilon'. The
+    // maximum number of states is shared between the stages.
+    if (parameters.epsilon < 0 || parameters.epsilon >= 1) {
+        throw std::invalid_argument(
+                "flexible_single_night_star_observation_scheduling::dynamic_programming\n"
+                "'epsilon' must be in [0, 1).");
+    }
+    bool approximate = parameters.epsilon > 0
+        || parameters.maximum_number_of_states < std::numeric_limits<Counter>::max();
+    double trim_factor = (instance.number_of_targets() == 0)?
+        1:
+        std::pow(1 - parameters.epsilon, -1.0 / instance.number_of_targets());
+    Counter stage_maximum_number_of_states = (std::max)(
+            (Counter)3,
+            parameters.maximum_number_of_states / (instance.number_of_targets() + 1));
+    double guarantee = 1;
+
+    // Compute states.
+    // The states of all stages are stored in a single arena. The states of
+    // stage 'target_pos' are stored between 'stage_starts[target_pos]' and
+    // 'stage_ends[target_pos]'. With an approximation, the states of a stage
+    // whose profit is close to the profit of an earlier state are removed.
+    starobservationschedulingsolver::ParetoStates states;
+    starobservationschedulingsolver::ParetoStageBuffers buffers;
+    std::vector<starobservationschedulingsolver::ParetoOption> options;
+    std::vector<int64_t> stage_starts(instance.number_of_targets() + 1, 0);
+    std::vector<int64_t> stage_ends(instance.number_of_targets() + 1, 0);
+    states.push_back(0, 0, -1, -1);
+    stage_ends[0] = 1;
+    for (TargetId target_pos = 0;
+            target_pos < instance.number_of_targets();
+            ++target_pos) {
+        TargetId target_id = sorted_targets[target_pos];
+        const Target& target = instance.target(target_id);
+        int64_t stage_start = stage_starts[target_pos];
+        int64_t stage_end = stage_ends[target_pos];
+        //std::cout << "target_pos " << target_pos
+        //    << " target_id " << target_id
+        //    << " meridian " << target.meridian
+        //    << " stage size " << stage_end - stage_start
+        //    << std::endl;
+
+        // Observing a target with a non-positive profit never improves a
+        // schedule.
+        // The observation must contain the meridian.
+        options.clear();
+        for (int32_t label = first_labels[target_id];
+                label < first_labels[target_id + 1];
+                ++label) {
+            Profit profit = label_profits[label];
+            if (profit <= 0)
+                continue;
+            Time observation_time = label_observation_times[label];
+            starobservationschedulingsolver::ParetoOption option;
+            option.release_date = std::max(target.release_date, target.meridian - observation_time);
+            option.latest_start = target.meridian;
+            option.deadline = target.deadline;
+            option.observation_time = observation_time;
+            option.profit = profit;
+            option.label = label;
+            options.push_back(option);
+        }
+        if (options.empty()) {
+            stage_starts[target_pos + 1] = stage_start;
+            stage_ends[target_pos + 1] = stage_end;
+            continue;
+        }
+
+        int64_t next_stage_start = starobservationschedulingsolver::compute_pareto_stage(
+                states,
+                stage_start,
+                stage_end,
+                starobservationschedulingsolver::Span<starobservationschedulingsolver::ParetoOption>(options),
+                buffers,
+                states);
+        if (approximate) {
+            guarantee /= starobservationschedulingsolver::trim_front(
+                    states,
+                    next_stage_start,
+                    trim_factor,
+                    stage_maximum_number_of_states);
+        }
+        if (states.size > std::numeric_limits<int32_t>::max()) {
+            throw std::runtime_error(
+                    "flexible_single_night_star_observation_scheduling::dynamic_programming\n"
+                    "Too many states.");
+        }
+        stage_starts[target_pos + 1] = next_stage_start;
+        stage_ends[target_pos + 1] = states.size;
+    }
+
+    // Find best state.
+    // States of a stage are sorted by increasing profit.
+    int64_t state_id_best = stage_ends[instance.number_of_targets()] - 1;
+    //std::cout << "s_best t " << states.times[state_id_best] << " profit " << states.profits[state_id_best] << std::endl;
+
+    // Retrieve solution.
+    std::vector<int64_t> solution_states;
+    for (int64_t state_id = state_id_best;
+            states.prevs[state_id] != -1;
+            state_id = states.prevs[state_id]) {
+        solution_states.push_back(state_id);
+    }
+    std::reverse(solution_states.begin(), solution_states.end());
+    for (int64_t state_id: solution_states) {
+        int32_t label = states.labels[state_id];
+        solution.append_observation(
+                label_targets[label],
+                label_observation_time_positions[label],
+                label_observation_times[label],
+                states.times[state_id] - label_observation_times[label]);
+    }
+    return guarantee;
+}
+
+void dynamic_programming_time_indexed(
+        const Instance& instance,
+        const std::vector<TargetId>& sorted_targets,
+        Solution& solution)
+{
+    // Compute the time origin and the horizon.
+    // Times are relative to the time origin.
+    Time time_origin = 0;
+    Time horizon = 0;
+    if (instance.number_of_targets() > 0) {
+        Time earliest_release_date = std::numeric_limits<Time>::max();
+        Time latest_deadline = std::numeric_limits<Time>::min();
+        for (TargetId target_id = 0;
+                target_id < instance.number_of_targets();
+                ++target_id) {
+            const Target& target = instance.target(target_id);
+            earliest_release_date = std::min(earliest_release_date, target.release_date);
+            latest_deadline = std::max(latest_deadline, target.deadline);
+        }
+        time_origin = std::max((Time)0, earliest_release_date);
+        horizon = std::max((Time)0, latest_deadline - time_origin);
+    }
+
+    // Compute values.
+    // The decisions of stage 'target_pos' are the ones of the times between
+    // 'decision_first_times[target_pos]' and 'decision_last_times[target_pos]'.
+    // 0 means that the value comes from the previous time, 1 that the target
+    // is not observed and '2 + observation_time_pos' that it is observed with
+    // this observation time and ends at this time.
+    // For the stages of the targets with observation time intervals, the
+    // observation times of the decisions between 'decision_first_times' and
+    // 'decision_last_times' are stored from
+    // 'interval_observation_time_starts[target_pos]'.
+    std::vector<Profit> values(horizon + 1, 0);
+    std::vector<Profit> extended_values(horizon + 1);
+    std::vector<uint8_t> decisions;
+    std::vector<int64_t> decision_starts(instance.number_of_targets(), 0);
+    std::vector<Time> decision_first_times(instance.number_of_targets(), 0);
+    std::vector<Time> decision_last_times(instance.number_of_targets(), -1);
+    std::vector<Time> interval_observation_times;
+    std::vector<int64_t> interval_observation_time_starts(instance.number_of_targets(), -1);
+    std::vector<Time> queue;
+    for (TargetId target_pos = 0;
+            target_pos < instance.number_of_targets();
+            ++target_pos) {
+        TargetId target_id = sorted_targets[target_pos];
+        const Target& target = instance.target(target_id);
+        starobservationschedulingsolver::Span<Time> observation_times = instance.observation_times(target_id);
+        starobservationschedulingsolver::Span<Profit> profits = instance.profits(target_id);
+        starobservationschedulingsolver::Span<ObservationTimeInterval> observation_time_intervals = instance.observation_time_intervals(target_id);
+        decision_starts[target_pos] = decisions.size();
+        if (target.number_of_observation_times + target.number_of_observation_time_intervals > 253) {
+            throw std::invalid_argument(
+                    "flexible_single_night_star_observation_scheduling::dynamic_programming\n"
+                    "The time-indexed engine doesn't support more than 253 "
+                    "observation times and observation time intervals per "
+                    "target.");
+        }
+
+        // Compute the end times of each observation time.
+        // The observation must contain the meridian.
+        Time release_date = std::max(target.release_date - time_origin, (Time)0);
+        Time meridian = target.meridian - time_origin;
+        Time deadline = std::min(target.deadline - time_origin, horizon);
+        Time first_time = horizon + 1;
+        Time last_time = -1;
+        for (Counter observation_time_pos = 0;
+                observation_time_pos < target.number_of_observation_times;
+                ++observation_time_pos) {
+            if (profits[observation_time_pos] <= 0)
+                continue;
+            Time observation_time = observation_times[observation_time_pos];
+            Time first_end = std::max(release_date, meridian - observation_time) + observation_time;
+            Time last_end = std::min(deadline, meridian + observation_time);
+            if (first_end > last_end)
+                continue;
+            first_time = std::min(first_time, first_end);
+            last_time = std::max(last_time, last_end);
+        }
+        for (const ObservationTimeInterval& interval: observation_time_intervals) {
+            if (interval.observation_time_profit(interval.minimum_observation_time) <= 0
+                    && interval.observation_time_profit(interval.maximum_observation_time) <= 0) {
+                continue;
+            }
+            Time first_end = std::max(release_date + interval.minimum_observation_time, meridian);
+            Time last_end = std::min(deadline, meridian + interval.maximum_observation_time);
+            if (release_date > meridian || first_end > last_end)
+                continue;
+            first_time = std::min(first_time, first_end);
+            last_time = std::max(last_time, last_end);
+        }
+        if (first_time > last_time)
+            continue;
+
+        std::copy(
+                values.begin() + first_time,
+                values.begin() + last_time + 1,
+                extended_values.begin() + first_time);
+        decisions.resize(decisions.size() + last_time - first_time + 1, 1);
+        for (Counter observation_time_pos = 0;
+                observation_time_pos < target.number_of_observation_times;
+                ++observation_time_pos) {
+            Profit profit = profits[observation_time_pos];
+            if (profit <= 0)
+                continue;
+            Time observation_time = observation_times[observation_time_pos];
+            Time first_end = std::max(release_date, meridian - observation_time) + observation_time;
+            Time last_end = std::min(deadline, meridian + observation_time);
+            if (first_end > last_end)
+                continue;
+            starobservationschedulingsolver::extend_values(
+                    values.data(),
+                    first_end,
+                    last_end,
+                    observation_time,
+                    profit,
+                    2 + observation_time_pos,
+                    extended_values.data(),
+                    decisions.data() + decision_starts[target_pos] + first_end - first_time);
+        }
+        if (target.number_of_observation_time_intervals > 0) {
+            interval_observation_time_starts[target_pos] = interval_observation_times.size();
+            interval_observation_times.resize(interval_observation_times.size() + last_time - first_time + 1);
+        }
+        for (Counter interval_pos = 0;
+                interval_pos < target.number_of_observation_time_intervals;
+                ++interval_pos) {
+            const ObservationTimeInterval& interval = observation_time_intervals[interval_pos];
+            if (interval.observation_time_profit(interval.minimum_observation_time) <= 0
+                    && interval.observation_time_profit(interval.maximum_observation_time) <= 0) {
+                continue;
+            }
+            Time first_end = std::max(release_date + interval.minimum_observation_time, meridian);
+            Time last_end = std::min(deadline, meridian + interval.maximum_observation_time);
+            if (release_date > meridian || first_end > last_end)
+                continue;
+            starobservationschedulingsolver::extend_values_interval(
+                    values.data(),
+                    release_date,
+                    meridian,
+                    first_end,
+                    last_end,
+                    interval.minimum_observation_time,
+                    interval.maximum_observation_time,
+                    interval.profit,
+                    interval.profit_slope,
+                    2 + target.number_of_observation_times + interval_pos,
+                    extended_values.data(),
+                    decisions.data() + decision_starts[target_pos] + first_end - first_time,
+                    interval_observation_times.data() + interval_observation_time_starts[target_pos] + first_end - first_time,
+                    queue);
+        }
+        decision_first_times[target_pos] = first_time;
+        decision_last_times[target_pos] = starobservationschedulingsolver::propagate_values(
+                values.data(),
+                horizon,
+                extended_values.data(),
+                first_time,
+                last_time,
+                decisions,
+                decision_starts[target_pos]);
+    }
+
+    // Retrieve solution.
+    std::vector<std::pair<TargetId, Counter>> solution_observations;
+    std::vector<Time> solution_observation_times;
+    std::vector<Time> solution_start_times;
+    Time time = horizon;
+    for (TargetId target_pos = instance.number_of_targets() - 1;
+            target_pos >= 0;
+            --target_pos) {
+        Time first_time = decision_first_times[target_pos];
+        Time last_time = decision_last_times[target_pos];
+        if (time < first_time || time > last_time)
+            continue;
+        const uint8_t* stage_decisions = decisions.data() + decision_starts[target_pos] - first_time;
+        while (time > first_time && stage_decisions[time] == 0)
+            time--;
+        if (stage_decisions[time] >= 2) {
+            TargetId target_id = sorted_targets[target_pos];
+            const Target& target = instance.target(target_id);
+            Counter observation_time_pos = stage_decisions[time] - 2;
+            Time observation_time = (observation_time_pos < target.number_of_observation_times)?
+                instance.observation_times(target_id)[observation_time_pos]:
+                interval_observation_times[interval_observation_time_starts[target_pos] + time - first_time];
+            solution_observations.push_back({target_id, observation_time_pos});
+            solution_observation_times.push_back(observation_time);
+            solution_start_times.push_back(time_origin + time - observation_time);
+            time -= observation_time;
+        }
+    }
+    for (Counter observation_pos = solution_observations.size() - 1;
+            observation_pos >= 0;
+            --observation_pos) {
+        solution.append_observation(
+                solution_observations[observation_pos].first,
+                solution_observations[observation_pos].second,
+                solution_observation_times[observation_pos],
+                solution_start_times[observation_pos]);
+    }
+}
+
+}
+
+std::istream& starobservationschedulingsolver::flexible_single_night_star_observation_scheduling::operator>>(
+        std::istream& in,
+        DynamicProgrammingEngine& engine)
+{
+    std::string token;
+    in >> token;
+    if (token == "auto") {
+        engine = DynamicProgrammingEngine::Auto;
+    } else if (token == "pareto") {
+        engine = DynamicProgrammingEngine::Pareto;
+    } else if (token == "time-indexed") {
+        engine = DynamicProgrammingEngine::TimeIndexed;
+    } else  {
+        in.setstate(std::ios_base::failbit);
+    }
+    return in;
+}
+
+std::ostream& starobservationschedulingsolver::flexible_single_night_star_observation_scheduling::operator<<(
         std::ostream& os,
-        const DynamicProgrammingState& s)
+        DynamicProgrammingEngine engine)
 {
-    os << "time " << s.time << " profit " << s.profit;
+    switch (engine) {
+    case DynamicProgrammingEngine::Auto: {
+        os << "auto";
+        break;
+    } case DynamicProgrammingEngine::Pareto: {
+        os << "pareto";
+        break;
+    } case DynamicProgrammingEngine::TimeIndexed: {
+        os << "time-indexed";
+        break;
+    }
+    }
     return os;
 }
-*/
 
+DynamicProgrammingEngine starobservationschedulingsolver::flexible_single_night_star_observation_scheduling::select_dynamic_programming_engine(
+        const Instance& instance)
+{
+    if (instance.number_of_targets() == 0)
+        return DynamicProgrammingEngine::Pareto;
+    Time earliest_release_date = std::numeric_limits<Time>::max();
+    Time latest_deadline = std::numeric_limits<Time>::min();
+    Counter number_of_interval_observation_times = 0;
+    for (TargetId target_id = 0;
+            target_id < instance.number_of_targets();
+            ++target_id) {
+        const Target& target = instance.target(target_id);
+        if (target.number_of_observation_times + target.number_of_observation_time_intervals > 253)
+            return DynamicProgrammingEngine::Pareto;
+        for (const ObservationTimeInterval& interval: instance.observation_time_intervals(target_id)) {
+            number_of_interval_observation_times
+                += interval.maximum_observation_time
+                - interval.minimum_observation_time + 1;
+        }
+        earliest_release_date = std::min(earliest_release_date, target.release_date);
+        latest_deadline = std::max(latest_deadline, target.deadline);
+    }
+    Time horizon = latest_deadline - std::max((Time)0, earliest_release_date);
+    if (horizon <= 10 * (instance.number_of_targets() + number_of_interval_observation_times))
+        return DynamicProgrammingEngine::TimeIndexed;
+    return DynamicProgrammingEngine::Pareto;
 }
 
 const Output starobservationschedulingsolver::flexible_single_night_star_observation_scheduling::dynamic_programming(
@@ -59,110 +481,22 @@ const Output starobservationschedulingsolver::flexible_single_night_star_observa
                     < instance.target(target_id_2).meridian;
             });
 
-    // Compute states.
-    std::vector<std::vector<DynamicProgrammingState>> states(instance.number_of_targets() + 1);
-    states[0].push_back({0, 0, -1, -1, nullptr});
-    std::vector<DynamicProgrammingState> states_cur = states[0];
-    std::vector<DynamicProgrammingState> states_next;
-    for (TargetId target_pos = 0;
-            target_pos < instance.number_of_targets();
-            ++target_pos) {
-        TargetId target_id = sorted_targets[target_pos];
-        const Target& target = instance.target(target_id);
-        //std::cout << "target_pos " << target_pos
-        //    << " target_id " << target_id
-        //    << " meridian " << target.meridian
-        //    << " states[target_pos].size() " << states[target_pos].size()
-        //    << std::endl;
-        for (Counter observation_time_pos = 0;
-                observation_time_pos < (Counter)target.observation_times.size();
-                ++observation_time_pos) {
-            Time observation_time = target.observation_times[observation_time_pos];
-            //std::cout << "observation_time_pos " << observation_time_pos
-            //    << " observation_time " << observation_time
-            //    << " profit " << target.profits[observation_time_pos]
-            //    << std::endl;
-            auto it = states_cur.begin();
-            auto it1 = states[target_pos].begin();
-            states_next.clear();
-            while (it != states_cur.end() || it1 != states[target_pos].end()) {
-                if (it1 != states[target_pos].end()
-                        && (it == states_cur.end()
-                            || it->time > std::max({it1->time, target.release_date, target.meridian - observation_time})
-                            + observation_time)) {
-                    if (it1->time > target.meridian) {
-                        it1++;
-                        continue;
-                    }
-
-                    DynamicProgrammingState s1 {
-                        std::max({it1->time, target.release_date, target.meridian - observation_time}) + observation_time,
-                        it1->profit + target.profits[observation_time_pos],
-                        target_id,
-                        observation_time_pos,
-                        &(*it1) };
-                    //std::cout << *it1 << " -> " << s1 << std::endl;
-
-                    if (s1.time > target.deadline) {
-                        it1++;
-                        continue;
-                    }
-
-                    if (states_next.empty()
-                            || s1.profit > states_next.back().profit) {
-                        if (!states_next.empty()
-                                && s1.time == states_next.back().time) {
-                            states_next.back() = s1;
-                        } else {
-                            states_next.push_back(s1);
-                        }
-                    }
-                    it1++;
-                } else {
-                    assert(it != states_next.end());
-                    //std::cout << *it << std::endl;
-                    if (states_next.empty()
-                            || it->profit > states_next.back().profit) {
-                        if (!states_next.empty()
-                                && it->time == states_next.back().time) {
-                            states_next.back() = *it;
-                        } else {
-                            states_next.push_back(*it);
-                        }
-                    }
-                    ++it;
-                }
-            }
-            states_cur.swap(states_next);
-        }
-        states[target_pos + 1] = states_cur;
-    }
-
-    // Find best state.
-    const DynamicProgrammingState* s_best = nullptr;
-    for (const DynamicProgrammingState& s: states[instance.number_of_targets()])
-        if (s_best == nullptr || s_best->profit < s.profit)
-            s_best = &s;
-    //std::cout << "s_best t " << s_best->time << " profit " << s_best->profit << std::endl;
+    // Select engine.
+    DynamicProgrammingEngine engine = parameters.engine;
+    if (engine == DynamicProgrammingEngine::Auto)
+        engine = select_dynamic_programming_engine(instance);
 
-    // Retrieve solution.
-    const DynamicProgrammingState* s_curr = s_best;
-    std::vector<const DynamicProgrammingState*> solution_states;
-    while (s_curr->prev != nullptr) {
-        solution_states.push_back(s_curr);
-        s_curr = s_curr->prev;
-    }
-    std::reverse(solution_states.begin(), solution_states.end());
-    for (const DynamicProgrammingState* state: solution_states) {
-        solution.append_observation(
-                state->target_id,
-                state->observation_time_pos,
-                state->time - instance.target(state->target_id).observation_times[state->observation_time_pos]);
+    // Only the Pareto engine is approximate.
+    double guarantee = 1;
+    if (engine == DynamicProgrammingEngine::TimeIndexed) {
+        dynamic_programming_time_indexed(instance, sorted_targets, solution);
+    } else {
+        guarantee = dynamic_programming_pareto(instance, sorted_targets, parameters, solution);
     }
     //std::cout << "solution.profit() " << solution.profit() << std::endl;
 
     algorithm_formatter.update_solution(solution, "");
-    algorithm_formatter.update_bound(solution.profit(), "");
+    algorithm_formatter.update_bound(solution.profit() / guarantee, "");
 
     algorithm_formatter.end();
     return output;
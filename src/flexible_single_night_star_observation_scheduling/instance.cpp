@@ -10,7 +10,8 @@ std::ostream& Instance::format(
 {
     if (verbosity_level >= 1) {
         os
-            << "Number of targets:  " << number_of_targets() << std::endl
+            << "Number of targets:                    " << number_of_targets() << std::endl
+            << "Number of removed observation times:  " << number_of_removed_observation_times() << std::endl
             ;
     }
 
@@ -55,12 +56,21 @@ std::ostream& Instance::format(
                 ++target_id) {
             const Target& target = this->target(target_id);
             for (Counter observation_time_pos = 0;
-                    observation_time_pos < (Counter)target.observation_times.size();
+                    observation_time_pos < target.number_of_observation_times;
                     ++observation_time_pos) {
                 os
                     << std::setw(12) << target_id
-                    << std::setw(12) << target.observation_times[observation_time_pos]
-                    << std::setw(12) << target.profits[observation_time_pos]
+                    << std::setw(12) << observation_times(target_id)[observation_time_pos]
+                    << std::setw(12) << profits(target_id)[observation_time_pos]
+                    << std::endl;
+            }
+            for (const ObservationTimeInterval& interval: observation_time_intervals(target_id)) {
+                os
+                    << std::setw(12) << target_id
+                    << std::setw(12) << std::to_string(interval.minimum_observation_time)
+                    + "-" + std::to_string(interval.maximum_observation_time)
+                    << std::setw(12) << interval.observation_time_profit(interval.minimum_observation_time)
+                    << "-" << interval.observation_time_profit(interval.maximum_observation_time)
                     << std::endl;
             }
         }
@@ -5,6 +5,36 @@
 
 using namespace starobservationschedulingsolver::flexible_single_night_star_observation_scheduling;
 
+namespace
+{
+
+/**
+ * Group elements by owner, keeping their order.
+ *
+ * Return the positions of the elements sorted by owner; the elements of
+ * owner 'owner' are between 'starts[owner]' and 'starts[owner + 1]'.
+ */
+std::vector<Counter> group_by_owner(
+        const std::vector<TargetId>& owners,
+        TargetId number_of_owners,
+        std::vector<Counter>& starts)
+{
+    starts.assign(number_of_owners + 1, 0);
+    for (TargetId owner: owners)
+        starts[owner + 1]++;
+    for (TargetId owner = 0; owner < number_of_owners; ++owner)
+        starts[owner + 1] += starts[owner];
+    std::vector<Counter> next_positions(starts.begin(), starts.end() - 1);
+    std::vector<Counter> sorted_positions(owners.size());
+    for (Counter pos = 0; pos < (Counter)owners.size(); ++pos) {
+        sorted_positions[next_positions[owners[pos]]] = pos;
+        next_positions[owners[pos]]++;
+    }
+    return sorted_positions;
+}
+
+}
+
 TargetId InstanceBuilder::add_target(
         Time release_date,
         Time meridian,
@@ -24,8 +54,31 @@ void InstanceBuilder::add_observation_time(
         Time observation_time,
         Profit profit)
 {
-    instance_.targets_[target_id].observation_times.push_back(observation_time);
-    instance_.targets_[target_id].profits.push_back(profit);
+    observation_time_targets_.push_back(target_id);
+    observation_times_.push_back(observation_time);
+    profits_.push_back(profit);
+}
+
+void InstanceBuilder::add_observation_time_interval(
+        TargetId target_id,
+        Time minimum_observation_time,
+        Time maximum_observation_time,
+        Profit profit,
+        Profit profit_slope)
+{
+    if (minimum_observation_time > maximum_observation_time) {
+        throw std::invalid_argument(
+                "flexible_single_night_star_observation_scheduling::InstanceBuilder::add_observation_time_interval\n"
+                "The minimum observation time must be smaller than or equal "
+                "to the maximum observation time.");
+    }
+    ObservationTimeInterval interval;
+    interval.minimum_observation_time = minimum_observation_time;
+    interval.maximum_observation_time = maximum_observation_time;
+    interval.profit = profit;
+    interval.profit_slope = profit_slope;
+    observation_time_interval_targets_.push_back(target_id);
+    observation_time_intervals_.push_back(interval);
 }
 
 void InstanceBuilder::read(
@@ -101,24 +154,105 @@ void InstanceBuilder::read_default(
                     observation_times[observation_time_pos],
                     profits[observation_time_pos]);
         }
+
+        // Optional observation time intervals:
+        // "q <number of intervals> (<min> <max> <profit> <slope>)*".
+        Counter number_of_intervals = 0;
+        if (iss >> null >> number_of_intervals) {
+            for (Counter interval_pos = 0;
+                    interval_pos < number_of_intervals;
+                    ++interval_pos) {
+                Time minimum_observation_time = -1;
+                Time maximum_observation_time = -1;
+                Profit profit_slope = 0;
+                iss >> minimum_observation_time
+                    >> maximum_observation_time
+                    >> profit
+                    >> profit_slope;
+                add_observation_time_interval(
+                        target_id,
+                        minimum_observation_time,
+                        maximum_observation_time,
+                        profit,
+                        profit_slope);
+            }
+        }
     }
 }
 
 Instance InstanceBuilder::build()
 {
-    // Compute maximum_profit for each target and profit_sum_.
+    // Store the observation times target by target, in the order in which
+    // they have been added, and reduce them.
+    std::vector<Counter> starts;
+    std::vector<Counter> sorted_positions = group_by_owner(
+            observation_time_targets_,
+            instance_.number_of_targets(),
+            starts);
+    instance_.observation_times_.reserve(observation_times_.size());
+    instance_.profits_.reserve(profits_.size());
+    std::vector<Time> target_observation_times;
+    std::vector<Profit> target_profits;
+    for (TargetId target_id = 0;
+            target_id < instance_.number_of_targets();
+            ++target_id) {
+        target_observation_times.clear();
+        target_profits.clear();
+        for (Counter pos = starts[target_id];
+                pos < starts[target_id + 1];
+                ++pos) {
+            target_observation_times.push_back(observation_times_[sorted_positions[pos]]);
+            target_profits.push_back(profits_[sorted_positions[pos]]);
+        }
+        std::vector<Counter> positions = reduce_observation_times<Time, Profit>(
+                target_observation_times,
+                target_profits,
+                observation_time_reduction_);
+        instance_.number_of_removed_observation_times_
+            += target_observation_times.size() - positions.size();
+        Target& target = instance_.targets_[target_id];
+        target.observation_times_start = instance_.observation_times_.size();
+        target.number_of_observation_times = positions.size();
+        for (Counter observation_time_pos: positions) {
+            instance_.observation_times_.push_back(target_observation_times[observation_time_pos]);
+            instance_.profits_.push_back(target_profits[observation_time_pos]);
+        }
+    }
+
+    // Store the observation time intervals target by target.
+    sorted_positions = group_by_owner(
+            observation_time_interval_targets_,
+            instance_.number_of_targets(),
+            starts);
+    instance_.observation_time_intervals_.reserve(observation_time_intervals_.size());
     for (TargetId target_id = 0;
             target_id < instance_.number_of_targets();
             ++target_id) {
-        const Target& target = instance_.target(target_id);
-        for (Time pos = 0;
-                pos < (Time)target.observation_times.size();
+        Target& target = instance_.targets_[target_id];
+        target.observation_time_intervals_start = starts[target_id];
+        target.number_of_observation_time_intervals = starts[target_id + 1] - starts[target_id];
+        for (Counter pos = starts[target_id];
+                pos < starts[target_id + 1];
                 ++pos) {
-            instance_.targets_[target_id].maximum_profit = std::max(
+            instance_.observation_time_intervals_.push_back(
+                    observation_time_intervals_[sorted_positions[pos]]);
+        }
+    }
+
+    // Compute maximum_profit for each target and profit_sum_.
+    for (TargetId target_id = 0;
+            target_id < instance_.number_of_targets();
+            ++target_id) {
+        Target& target = instance_.targets_[target_id];
+        for (Profit profit: instance_.profits(target_id))
+            target.maximum_profit = std::max(target.maximum_profit, profit);
+        for (const ObservationTimeInterval& interval: instance_.observation_time_intervals(target_id)) {
+            target.maximum_profit = std::max({
                     target.maximum_profit,
-                    target.profits[pos]);
+                    interval.observation_time_profit(interval.minimum_observation_time),
+                    interval.observation_time_profit(interval.maximum_observation_time)});
         }
-        instance_.total_profit_ += target.maximum_profit;;
+        instance_.total_profit_ += target.maximum_profit;
     }
 
     return std::move(instance_);
@@ -49,6 +49,12 @@ Output run(
     if (algorithm == "dynamic-programming") {
         DynamicProgrammingOptionalParameters parameters;
         read_args(parameters, vm);
+        if (vm.count("engine"))
+            parameters.engine = vm["engine"].as<DynamicProgrammingEngine>();
+        if (vm.count("epsilon"))
+            parameters.epsilon = vm["epsilon"].as<double>();
+        if (vm.count("maximum-number-of-states"))
+            parameters.maximum_number_of_states = vm["maximum-number-of-states"].as<Counter>();
         return dynamic_programming(instance, parameters);
 
     } else {
@@ -76,9 +82,13 @@ int main(int argc, char *argv[])
         ("only-write-at-the-end,e", "only write output and certificate files at the end")
         ("log,l", po::value<std::string>(), "set log file")
         ("log-to-stderr", "write log to stderr")
+        ("observation-time-reduction,", po::value<starobservationschedulingsolver::ObservationTimeReduction>(), "set the reduction of the observation times (none, dominance, concave-hull)")
 
         ("maximum-number-of-iterations,", po::value<int>(), "set the maximum number of iterations")
         ("maximum-number-of-iterations-without-improvement,", po::value<int>(), "set the maximum number of iterations without improvement")
+        ("engine,", po::value<DynamicProgrammingEngine>(), "set the dynamic programming engine (auto, pareto, time-indexed)")
+        ("epsilon,", po::value<double>(), "set the relative accuracy of the Pareto engine")
+        ("maximum-number-of-states,", po::value<Counter>(), "set the maximum number of states of the Pareto engine")
         ;
     po::variables_map vm;
     po::store(po::parse_command_line(argc, argv, desc), vm);
@@ -95,6 +105,8 @@ int main(int argc, char *argv[])
 
     // Build instance.
     InstanceBuilder instance_builder;
+    if (vm.count("observation-time-reduction"))
+        instance_builder.set_observation_time_reduction(vm["observation-time-reduction"].as<starobservationschedulingsolver::ObservationTimeReduction>());
     instance_builder.read(
             vm["input"].as<std::string>(),
             vm["format"].as<std::string>());
@@ -14,9 +14,45 @@ void Solution::append_observation(
         TargetId target_id,
         Counter observation_time_pos,
         Time start_time)
+{
+    if (observation_time_pos >= instance().target(target_id).number_of_observation_times) {
+        throw std::invalid_argument(
+                "flexible_single_night_star_observation_scheduling::Solution::append_observation\n"
+                "Observation time position " + std::to_string(observation_time_pos)
+                + " of target " + std::to_string(target_id)
+                + " is an observation time interval; its observation time must be given.");
+    }
+    append_observation(
+            target_id,
+            observation_time_pos,
+            instance().observation_times(target_id)[observation_time_pos],
+            start_time);
+}
+
+void Solution::append_observation(
+        TargetId target_id,
+        Counter observation_time_pos,
+        Time observation_time,
+        Time start_time)
 {
     const Target& target = instance().target(target_id);
-    Time observation_time = target.observation_times[observation_time_pos];
+    Profit profit = 0;
+    if (observation_time_pos < target.number_of_observation_times) {
+        if (observation_time != instance().observation_times(target_id)[observation_time_pos]) {
+            throw std::runtime_error(
+                    "observation_time != instance().observation_times(target_id)[observation_time_pos]");
+        }
+        profit = instance().profits(target_id)[observation_time_pos];
+    } else {
+        const ObservationTimeInterval& interval = instance().observation_time_intervals(target_id)[
+            observation_time_pos - target.number_of_observation_times];
+        if (observation_time < interval.minimum_observation_time
+                || observation_time > interval.maximum_observation_time) {
+            throw std::runtime_error(
+                    "observation_time not in the observation time interval");
+        }
+        profit = interval.observation_time_profit(observation_time);
+    }
     if (target.release_date > start_time) {
         throw std::runtime_error(
                 "target.release_date > start_time");
@@ -45,12 +81,14 @@ void Solution::append_observation(
     Observation observation;
     observation.target_id = target_id;
     observation.observation_time_pos = observation_time_pos;
+    observation.observation_time = observation_time;
+    observation.profit = profit;
     observation.start_time = start_time;
     observations_.push_back(observation);
 
     targets_[target_id] = 1;
     current_time_ = start_time + observation_time;
-    profit_ += target.profits[observation_time_pos];
+    profit_ += profit;
 }
 
 std::ostream& Solution::format(
@@ -81,12 +119,11 @@ std::ostream& Solution::format(
                 observation_pos < number_of_observations();
                 ++observation_pos) {
             const Observation& observation = this->observation(observation_pos);
-            const Target& target = instance().target(observation.target_id);
             os
                 << std::setw(12) << observation.target_id
                 << std::setw(12) << observation.observation_time_pos
                 << std::setw(12) << observation.start_time
-                << std::setw(12) << observation.start_time + target.observation_times[observation.observation_time_pos]
+                << std::setw(12) << observation.start_time + observation.observation_time
                 << std::endl;
         }
     }
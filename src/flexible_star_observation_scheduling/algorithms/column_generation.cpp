@@ -38,6 +38,7 @@
 
 #include "starobservationschedulingsolver/flexible_single_night_star_observation_scheduling/instance_builder.hpp"
 #include "starobservationschedulingsolver/flexible_single_night_star_observation_scheduling/algorithms/dynamic_programming.hpp"
+#include "starobservationschedulingsolver/utils/observation_times.hpp"
 
 #include "columngenerationsolver/commons.hpp"
 #include "columngenerationsolver/algorithms/greedy.hpp"
@@ -78,6 +79,10 @@ private:
 
     std::vector<std::pair<TargetId, std::vector<Counter>>> snsosp2sosp_;
 
+    std::vector<Profit> reduced_profits_;
+
+    std::vector<Counter> interval_positions_;
+
 };
 
 columngenerationsolver::Model get_model(
@@ -169,28 +174,62 @@ PricingOutput PricingSolver::solve_pricing(
             const Observable& observable = instance_.observable(night_id, observable_id);
             if (fixed_targets_[observable.target_id] == 1)
                 continue;
-            starobservationschedulingsolver::flexible_single_night_star_observation_scheduling::TargetId snsosp_target_id = -1;
+
+            // Only keep the observation times which are not dominated for
+            // the reduced profits. This also removes the observation times
+            // with a non-positive reduced profit.
+            reduced_profits_.clear();
             for (Counter observation_time_pos = 0;
-                    observation_time_pos < (Counter)observable.observation_times.size();
+                    observation_time_pos < observable.number_of_observation_times;
                     ++observation_time_pos) {
-                starobservationschedulingsolver::flexible_single_night_star_observation_scheduling::Profit profit
-                    = observable.profits[observation_time_pos]
-                    - duals[instance_.number_of_nights() + observable.target_id];
-                if (profit <= 0)
-                    continue;
-                if (snsosp_target_id == -1) {
-                    snsosp_target_id = snsosp_instance_builder.add_target(
-                            observable.release_date,
-                            observable.meridian,
-                            observable.deadline);
-                    snsosp2sosp_.push_back({observable_id, std::vector<Counter>()});
+                reduced_profits_.push_back(
+                        instance_.profits(night_id, observable_id)[observation_time_pos]
+                        - duals[instance_.number_of_nights() + observable.target_id]);
+            }
+            std::vector<Counter> observation_time_positions = starobservationschedulingsolver::reduce_observation_times<Time, Profit>(
+                    instance_.observation_times(night_id, observable_id),
+                    reduced_profits_,
+                    starobservationschedulingsolver::ObservationTimeReduction::Dominance);
+            Value dual = duals[instance_.number_of_nights() + observable.target_id];
+            interval_positions_.clear();
+            for (Counter interval_pos = 0;
+                    interval_pos < observable.number_of_observation_time_intervals;
+                    ++interval_pos) {
+                const ObservationTimeInterval& interval = instance_.observation_time_intervals(night_id, observable_id)[interval_pos];
+                if (interval.observation_time_profit(interval.minimum_observation_time) > dual
+                        || interval.observation_time_profit(interval.maximum_observation_time) > dual) {
+                    interval_positions_.push_back(interval_pos);
                 }
+            }
+            if (observation_time_positions.empty()
+                    && interval_positions_.empty()) {
+                continue;
+            }
+
+            starobservationschedulingsolver::flexible_single_night_star_observation_scheduling::TargetId snsosp_target_id
+                = snsosp_instance_builder.add_target(
+                        observable.release_date,
+                        observable.meridian,
+                        observable.deadline);
+            snsosp2sosp_.push_back({observable_id, std::vector<Counter>()});
+            for (Counter observation_time_pos: observation_time_positions) {
                 snsosp_instance_builder.add_observation_time(
                         snsosp_target_id,
-                        observable.observation_times[observation_time_pos],
-                        profit);
+                        instance_.observation_times(night_id, observable_id)[observation_time_pos],
+                        reduced_profits_[observation_time_pos]);
                 snsosp2sosp_[snsosp_target_id].second.push_back(observation_time_pos);
             }
+            for (Counter interval_pos: interval_positions_) {
+                const ObservationTimeInterval& interval = instance_.observation_time_intervals(night_id, observable_id)[interval_pos];
+                snsosp_instance_builder.add_observation_time_interval(
+                        snsosp_target_id,
+                        interval.minimum_observation_time,
+                        interval.maximum_observation_time,
+                        interval.profit - dual,
+                        interval.profit_slope);
+                snsosp2sosp_[snsosp_target_id].second.push_back(
+                        observable.number_of_observation_times + interval_pos);
+            }
         }
         starobservationschedulingsolver::flexible_single_night_star_observation_scheduling::Instance snsosp_instance = snsosp_instance_builder.build();
 
@@ -221,7 +260,14 @@ PricingOutput PricingSolver::solve_pricing(
             element.row = instance_.number_of_nights() + observable.target_id;
             element.coefficient = 1;
             column.elements.push_back(element);
-            column.objective_coefficient += observable.profits[observation_time_pos];
+            if (observation_time_pos < observable.number_of_observation_times) {
+                column.objective_coefficient += instance_.profits(night_id, observable_id)[observation_time_pos];
+            } else {
+                const ObservationTimeInterval& interval = instance_.observation_time_intervals(night_id, observable_id)[
+                    observation_time_pos - observable.number_of_observation_times];
+                column.objective_coefficient += interval.observation_time_profit(
+                        snsosp_observation.observation_time);
+            }
         }
         // Extra.
         ColumnExtra extra {night_id, snsosp_output.solution, snsosp2sosp_};
@@ -241,7 +287,7 @@ Solution columns2solution(
         const Instance& instance,
         const columngenerationsolver::Solution& cg_solution)
 {
-    std::vector<std::vector<std::tuple<ObservableId, Counter, Time>>> sol(instance.number_of_nights());
+    std::vector<std::vector<std::tuple<ObservableId, Counter, Time, Time>>> sol(instance.number_of_nights());
     for (const auto& colval: cg_solution.columns()) {
         std::shared_ptr<ColumnExtra> extra
             = std::static_pointer_cast<ColumnExtra>(colval.first->extra);
@@ -251,10 +297,11 @@ Solution columns2solution(
             const auto& snsosp_observation = extra->snsosp_solution.observation(snsosp_observation_pos);
             ObservableId observable_id = extra->snsosp2sosp[snsosp_observation.target_id].first;
             Counter observation_time_pos = extra->snsosp2sosp[snsosp_observation.target_id].second[snsosp_observation.observation_time_pos];
-            sol[extra->night_id].push_back({
+            sol[extra->night_id].push_back(std::make_tuple(
                     observable_id,
                     observation_time_pos,
-                    snsosp_observation.start_time});
+                    snsosp_observation.start_time,
+                    snsosp_observation.observation_time));
         }
     }
 
@@ -266,8 +313,8 @@ Solution columns2solution(
                 sol[night_id].begin(),
                 sol[night_id].end(),
                 [](
-                    const std::tuple<ObservableId, Counter, Time>& os1,
-                    const std::tuple<ObservableId, Counter, Time>& os2) -> bool
+                    const std::tuple<ObservableId, Counter, Time, Time>& os1,
+                    const std::tuple<ObservableId, Counter, Time, Time>& os2) -> bool
                 {
                     return std::get<2>(os1) < std::get<2>(os2);
                 });
@@ -276,6 +323,7 @@ Solution columns2solution(
                     night_id,
                     std::get<0>(os),
                     std::get<1>(os),
+                    std::get<3>(os),
                     std::get<2>(os));
         }
     }
@@ -15,10 +15,17 @@ std::ostream& Instance::format(
 {
     if (verbosity_level >= 1) {
         os
-            << "Number of nights:       " << number_of_nights() << std::endl
-            << "Number of targets:      " << number_of_targets() << std::endl
-            << "Number of observables:  " << number_of_observables() << std::endl
+            << "Number of nights:                     " << number_of_nights() << std::endl
+            << "Number of targets:                    " << number_of_targets() << std::endl
+            << "Number of observables:                " << number_of_observables() << std::endl
+            << "Number of removed observation times:  " << number_of_removed_observation_times() << std::endl
             ;
+        if (reduced()) {
+            os
+                << "Number of infeasible observables:     " << number_of_infeasible_observables() << std::endl
+                << "Number of unprofitable targets:       " << number_of_unprofitable_targets() << std::endl
+                ;
+        }
     }
 
     if (verbosity_level >= 2) {
@@ -78,14 +85,25 @@ std::ostream& Instance::format(
                     ++observable_id) {
                 const Observable& observable = this->observable(night_id, observable_id);
                 for (Counter observation_time_pos = 0;
-                        observation_time_pos < (Counter)observable.observation_times.size();
+                        observation_time_pos < observable.number_of_observation_times;
                         ++observation_time_pos) {
                     os
                         << std::setw(12) << night_id
                         << std::setw(12) << observable_id
                         << std::setw(12) << observable.target_id
-                        << std::setw(12) << observable.observation_times[observation_time_pos]
-                        << std::setw(12) << observable.profits[observation_time_pos]
+                        << std::setw(12) << observation_times(night_id, observable_id)[observation_time_pos]
+                        << std::setw(12) << profits(night_id, observable_id)[observation_time_pos]
+                        << std::endl;
+                }
+                for (const ObservationTimeInterval& interval: observation_time_intervals(night_id, observable_id)) {
+                    os
+                        << std::setw(12) << night_id
+                        << std::setw(12) << observable_id
+                        << std::setw(12) << observable.target_id
+                        << std::setw(12) << std::to_string(interval.minimum_observation_time)
+                        + "-" + std::to_string(interval.maximum_observation_time)
+                        << std::setw(12) << interval.observation_time_profit(interval.minimum_observation_time)
+                        << "-" << interval.observation_time_profit(interval.maximum_observation_time)
                         << std::endl;
                 }
             }
@@ -136,17 +154,27 @@ void Instance::write(
                 ++night_id) {
             file << "Night " << night_id << ":";
             if (night2observable.contains(night_id)) {
-                const Observable& observable = this->observable(night_id, night2observable[night_id]);
-                file << " p " << observable.observation_times.size();
+                ObservableId observable_id = night2observable[night_id];
+                const Observable& observable = this->observable(night_id, observable_id);
+                file << " p " << observable.number_of_observation_times;
                 for (Counter observation_time_pos = 0;
-                        observation_time_pos < (Counter)observable.observation_times.size();
+                        observation_time_pos < observable.number_of_observation_times;
                         ++observation_time_pos) {
-                    file << " " << observable.observation_times[observation_time_pos]
-                        << " " << observable.profits[observation_time_pos];
+                    file << " " << observation_times(night_id, observable_id)[observation_time_pos]
+                        << " " << profits(night_id, observable_id)[observation_time_pos];
                 }
                 file << " r " << observable.release_date
                     << " m " << observable.meridian
                     << " d " << observable.deadline;
+                if (observable.number_of_observation_time_intervals > 0) {
+                    file << " q " << observable.number_of_observation_time_intervals;
+                    for (const ObservationTimeInterval& interval: observation_time_intervals(night_id, observable_id)) {
+                        file << " " << interval.minimum_observation_time
+                            << " " << interval.maximum_observation_time
+                            << " " << interval.profit
+                            << " " << interval.profit_slope;
+                    }
+                }
             }
             file << std::endl;
         }
@@ -164,6 +192,12 @@ std::pair<bool, Profit> Instance::check(
                 "flexible_star_observation_scheduling::Instance::check\n"
                 "Unable to open file \"" + certificate_path + "\".");
     }
+    if (reduced()) {
+        throw std::invalid_argument(
+                "flexible_star_observation_scheduling::Instance::check\n"
+                "Certificates use the original ids; "
+                "check them with the instance built without reduction.");
+    }
 
     if (verbosity_level >= 2) {
         os << std::endl
@@ -186,6 +220,7 @@ std::pair<bool, Profit> Instance::check(
     Profit profit = 0;
     TargetId number_of_duplicates = 0;
     TargetId number_of_deadline_violations = 0;
+    TargetId number_of_observation_time_violations = 0;
     for (NightId night_id = 0; night_id < number_of_nights(); ++night_id) {
 
         Time time = 0;
@@ -209,10 +244,34 @@ std::pair<bool, Profit> Instance::check(
             }
             targets.add(observable.target_id);
 
+            // The observation time of an interval position is given by the
+            // certificate.
+            Time observation_time = 0;
+            Profit observation_profit = 0;
+            if (observation_time_pos < observable.number_of_observation_times) {
+                observation_time = observation_times(night_id, observable_id)[observation_time_pos];
+                observation_profit = profits(night_id, observable_id)[observation_time_pos];
+            } else {
+                file >> observation_time;
+                const ObservationTimeInterval& interval = observation_time_intervals(night_id, observable_id)[
+                    observation_time_pos - observable.number_of_observation_times];
+                observation_profit = interval.observation_time_profit(observation_time);
+
+                // Check observation time.
+                if (observation_time < interval.minimum_observation_time
+                        || observation_time > interval.maximum_observation_time) {
+                    number_of_observation_time_violations++;
+                    if (verbosity_level >= 2) {
+                        os << "Observation " << observable_id
+                            << " has an observation time outside of its interval." << std::endl;
+                    }
+                }
+            }
+
             if (time < observable.release_date)
                 time = observable.release_date;
-            time += observable.observation_times[observation_time_pos];
-            profit += observable.profits[observation_time_pos];
+            time += observation_time;
+            profit += observation_profit;
 
             if (verbosity_level >= 2) {
                 os
@@ -239,7 +298,8 @@ std::pair<bool, Profit> Instance::check(
 
     bool feasible
         = (number_of_duplicates == 0)
-        && (number_of_deadline_violations == 0);
+        && (number_of_deadline_violations == 0)
+        && (number_of_observation_time_violations == 0);
 
     if (verbosity_level >= 2)
         os << std::endl;
@@ -248,6 +308,7 @@ std::pair<bool, Profit> Instance::check(
             << "Number of obsertions:           " << targets.size() << " / " << number_of_targets()  << std::endl
             << "Number of duplicates:           " << number_of_duplicates << std::endl
             << "Number of deadline violations:  " << number_of_deadline_violations << std::endl
+            << "Number of obs. time violations: " << number_of_observation_time_violations << std::endl
             << "Feasible:                       " << feasible << std::endl
             << "Profit:                         " << profit << std::endl
             ;
@@ -2,9 +2,41 @@
 
 #include <fstream>
 #include <sstream>
+#include <algorithm>
+#include <limits>
 
 using namespace starobservationschedulingsolver::flexible_star_observation_scheduling;
 
+namespace
+{
+
+/**
+ * Group elements by owner, keeping their order.
+ *
+ * Return the positions of the elements sorted by owner; the elements of
+ * owner 'owner' are between 'starts[owner]' and 'starts[owner + 1]'.
+ */
+std::vector<Counter> group_by_owner(
+        const std::vector<ObservableId>& owners,
+        ObservableId number_of_owners,
+        std::vector<Counter>& starts)
+{
+    starts.assign(number_of_owners + 1, 0);
+    for (ObservableId owner: owners)
+        starts[owner + 1]++;
+    for (ObservableId owner = 0; owner < number_of_owners; ++owner)
+        starts[owner + 1] += starts[owner];
+    std::vector<Counter> next_positions(starts.begin(), starts.end() - 1);
+    std::vector<Counter> sorted_positions(owners.size());
+    for (Counter pos = 0; pos < (Counter)owners.size(); ++pos) {
+        sorted_positions[next_positions[owners[pos]]] = pos;
+        next_positions[owners[pos]]++;
+    }
+    return sorted_positions;
+}
+
+}
+
 void InstanceBuilder::set_number_of_nights(
         NightId number_of_nights)
 {
@@ -40,8 +72,32 @@ void InstanceBuilder::add_observation_time(
         Time observation_time,
         Profit profit)
 {
-    instance_.observables_[night_id][observable_id].observation_times.push_back(observation_time);
-    instance_.observables_[night_id][observable_id].profits.push_back(profit);
+    observation_time_observables_.push_back({night_id, observable_id});
+    observation_times_.push_back(observation_time);
+    profits_.push_back(profit);
+}
+
+void InstanceBuilder::add_observation_time_interval(
+        NightId night_id,
+        ObservableId observable_id,
+        Time minimum_observation_time,
+        Time maximum_observation_time,
+        Profit profit,
+        Profit profit_slope)
+{
+    if (minimum_observation_time > maximum_observation_time) {
+        throw std::invalid_argument(
+                "flexible_star_observation_scheduling::InstanceBuilder::add_observation_time_interval\n"
+                "The minimum observation time must be smaller than or equal "
+                "to the maximum observation time.");
+    }
+    ObservationTimeInterval interval;
+    interval.minimum_observation_time = minimum_observation_time;
+    interval.maximum_observation_time = maximum_observation_time;
+    interval.profit = profit;
+    interval.profit_slope = profit_slope;
+    observation_time_interval_observables_.push_back({night_id, observable_id});
+    observation_time_intervals_.push_back(interval);
 }
 
 void InstanceBuilder::read(
@@ -135,35 +191,302 @@ void InstanceBuilder::read_catusse2016(
                         observation_times[observation_time_pos],
                         profits[observation_time_pos]);
             }
+
+            // Optional observation time intervals:
+            // "q <number of intervals> (<min> <max> <profit> <slope>)*".
+            Counter number_of_intervals = 0;
+            if (iss >> null >> number_of_intervals) {
+                for (Counter interval_pos = 0;
+                        interval_pos < number_of_intervals;
+                        ++interval_pos) {
+                    Time minimum_observation_time = -1;
+                    Time maximum_observation_time = -1;
+                    Profit profit_slope = 0;
+                    iss >> minimum_observation_time
+                        >> maximum_observation_time
+                        >> profit
+                        >> profit_slope;
+                    add_observation_time_interval(
+                            night_id,
+                            observable_id,
+                            minimum_observation_time,
+                            maximum_observation_time,
+                            profit,
+                            profit_slope);
+                }
+            }
+        }
+    }
+}
+
+void InstanceBuilder::reduce()
+{
+    NightId number_of_nights = instance_.number_of_nights();
+    TargetId number_of_targets = instance_.number_of_targets();
+    auto earliest_start = [](const Observable& observable)
+    {
+        return (std::max)((Time)0, observable.release_date);
+    };
+
+    // Compute the shortest observation time and the maximum profit of each
+    // observable, over its observation times and its observation time
+    // intervals.
+    std::vector<std::vector<Time>> shortest_observation_times(number_of_nights);
+    std::vector<std::vector<Profit>> maximum_profits(number_of_nights);
+    for (NightId night_id = 0;
+            night_id < number_of_nights;
+            ++night_id) {
+        shortest_observation_times[night_id].resize(
+                instance_.number_of_observables(night_id),
+                std::numeric_limits<Time>::max());
+        maximum_profits[night_id].resize(
+                instance_.number_of_observables(night_id),
+                std::numeric_limits<Profit>::lowest());
+    }
+    for (Counter pos = 0;
+            pos < (Counter)observation_times_.size();
+            ++pos) {
+        NightId night_id = observation_time_observables_[pos].first;
+        ObservableId observable_id = observation_time_observables_[pos].second;
+        Time& shortest_observation_time = shortest_observation_times[night_id][observable_id];
+        Profit& maximum_profit = maximum_profits[night_id][observable_id];
+        shortest_observation_time = (std::min)(shortest_observation_time, observation_times_[pos]);
+        maximum_profit = (std::max)(maximum_profit, profits_[pos]);
+    }
+    for (Counter pos = 0;
+            pos < (Counter)observation_time_intervals_.size();
+            ++pos) {
+        NightId night_id = observation_time_interval_observables_[pos].first;
+        ObservableId observable_id = observation_time_interval_observables_[pos].second;
+        const ObservationTimeInterval& interval = observation_time_intervals_[pos];
+        Time& shortest_observation_time = shortest_observation_times[night_id][observable_id];
+        Profit& maximum_profit = maximum_profits[night_id][observable_id];
+        shortest_observation_time = (std::min)(shortest_observation_time, interval.minimum_observation_time);
+        maximum_profit = (std::max)({
+                maximum_profit,
+                interval.observation_time_profit(interval.minimum_observation_time),
+                interval.observation_time_profit(interval.maximum_observation_time)});
+    }
+
+    // The profit of a target is the maximum profit of its observables.
+    std::vector<Profit> target_profits(number_of_targets, std::numeric_limits<Profit>::lowest());
+    for (NightId night_id = 0;
+            night_id < number_of_nights;
+            ++night_id) {
+        for (ObservableId observable_id = 0;
+                observable_id < instance_.number_of_observables(night_id);
+                ++observable_id) {
+            Profit& target_profit = target_profits[instance_.observables_[night_id][observable_id].target_id];
+            target_profit = (std::max)(target_profit, maximum_profits[night_id][observable_id]);
+        }
+    }
+
+    // Remove the observables whose shortest observation time doesn't fit in
+    // their time window and the observables of the targets without positive
+    // profit.
+    std::vector<std::vector<bool>> remaining(number_of_nights);
+    std::vector<Counter> target_number_of_remaining_observables(number_of_targets, 0);
+    for (NightId night_id = 0;
+            night_id < number_of_nights;
+            ++night_id) {
+        remaining[night_id].resize(instance_.number_of_observables(night_id), false);
+        for (ObservableId observable_id = 0;
+                observable_id < instance_.number_of_observables(night_id);
+                ++observable_id) {
+            const Observable& observable = instance_.observables_[night_id][observable_id];
+            if (observable.deadline - earliest_start(observable)
+                    < shortest_observation_times[night_id][observable_id]) {
+                instance_.number_of_infeasible_observables_++;
+                continue;
+            }
+            if (target_profits[observable.target_id] <= 0)
+                continue;
+            remaining[night_id][observable_id] = true;
+            target_number_of_remaining_observables[observable.target_id]++;
+        }
+    }
+    for (TargetId target_id = 0;
+            target_id < number_of_targets;
+            ++target_id) {
+        if (target_profits[target_id] <= 0)
+            instance_.number_of_unprofitable_targets_++;
+    }
+
+    // Build the reduced targets.
+    std::vector<TargetId> new_target_ids(number_of_targets, -1);
+    for (TargetId target_id = 0;
+            target_id < number_of_targets;
+            ++target_id) {
+        if (target_number_of_remaining_observables[target_id] == 0)
+            continue;
+        new_target_ids[target_id] = instance_.original_target_ids_.size();
+        instance_.original_target_ids_.push_back(target_id);
+    }
+
+    // Build the reduced observables.
+    std::vector<std::vector<Observable>> observables(number_of_nights);
+    std::vector<std::vector<ObservableId>> new_observable_ids(number_of_nights);
+    instance_.original_observable_ids_.resize(number_of_nights);
+    for (NightId night_id = 0;
+            night_id < number_of_nights;
+            ++night_id) {
+        new_observable_ids[night_id].resize(instance_.number_of_observables(night_id), -1);
+        for (ObservableId observable_id = 0;
+                observable_id < instance_.number_of_observables(night_id);
+                ++observable_id) {
+            if (!remaining[night_id][observable_id])
+                continue;
+            Observable observable = instance_.observables_[night_id][observable_id];
+            observable.target_id = new_target_ids[observable.target_id];
+            new_observable_ids[night_id][observable_id] = observables[night_id].size();
+            observables[night_id].push_back(observable);
+            instance_.original_observable_ids_[night_id].push_back(observable_id);
         }
     }
+
+    // Keep the observation times and the observation time intervals of the
+    // remaining observables, in the order in which they have been added.
+    Counter new_pos = 0;
+    for (Counter pos = 0;
+            pos < (Counter)observation_times_.size();
+            ++pos) {
+        NightId night_id = observation_time_observables_[pos].first;
+        ObservableId observable_id = new_observable_ids[night_id][observation_time_observables_[pos].second];
+        if (observable_id == -1)
+            continue;
+        observation_time_observables_[new_pos] = {night_id, observable_id};
+        observation_times_[new_pos] = observation_times_[pos];
+        profits_[new_pos] = profits_[pos];
+        new_pos++;
+    }
+    observation_time_observables_.resize(new_pos);
+    observation_times_.resize(new_pos);
+    profits_.resize(new_pos);
+    new_pos = 0;
+    for (Counter pos = 0;
+            pos < (Counter)observation_time_intervals_.size();
+            ++pos) {
+        NightId night_id = observation_time_interval_observables_[pos].first;
+        ObservableId observable_id = new_observable_ids[night_id][observation_time_interval_observables_[pos].second];
+        if (observable_id == -1)
+            continue;
+        observation_time_interval_observables_[new_pos] = {night_id, observable_id};
+        observation_time_intervals_[new_pos] = observation_time_intervals_[pos];
+        new_pos++;
+    }
+    observation_time_interval_observables_.resize(new_pos);
+    observation_time_intervals_.resize(new_pos);
+
+    instance_.observables_ = std::move(observables);
+    instance_.number_of_targets_ = instance_.original_target_ids_.size();
+    instance_.reduced_ = true;
 }
 
 Instance InstanceBuilder::build()
 {
+    if (reduction_)
+        reduce();
+
     // Compute number_of_observables_.
+    // The observables are numbered night by night.
+    std::vector<ObservableId> night_starts(instance_.number_of_nights() + 1, 0);
     for (NightId night_id = 0;
             night_id < instance_.number_of_nights();
             ++night_id) {
         instance_.number_of_observables_ += instance_.observables_[night_id].size();
+        night_starts[night_id + 1] = instance_.number_of_observables_;
     }
 
-    // Compute maximum_profit for each observable and profit_sum_.
+    // Store the observation times observable by observable, in the order in
+    // which they have been added, and reduce them.
+    std::vector<ObservableId> owners;
+    for (const auto& p: observation_time_observables_)
+        owners.push_back(night_starts[p.first] + p.second);
+    std::vector<Counter> starts;
+    std::vector<Counter> sorted_positions = group_by_owner(
+            owners,
+            instance_.number_of_observables_,
+            starts);
+    instance_.observation_times_.reserve(observation_times_.size());
+    instance_.profits_.reserve(profits_.size());
+    std::vector<Time> observable_observation_times;
+    std::vector<Profit> observable_profits;
     for (NightId night_id = 0;
             night_id < instance_.number_of_nights();
             ++night_id) {
         for (ObservableId observable_id = 0;
                 observable_id < instance_.number_of_observables(night_id);
                 ++observable_id) {
-            const Observable& observable = instance_.observable(night_id, observable_id);
-            for (Time pos = 0;
-                    pos < (Time)observable.observation_times.size();
+            ObservableId owner = night_starts[night_id] + observable_id;
+            observable_observation_times.clear();
+            observable_profits.clear();
+            for (Counter pos = starts[owner];
+                    pos < starts[owner + 1];
                     ++pos) {
-                instance_.observables_[night_id][observable_id].maximum_profit = std::max(
+                observable_observation_times.push_back(observation_times_[sorted_positions[pos]]);
+                observable_profits.push_back(profits_[sorted_positions[pos]]);
+            }
+            std::vector<Counter> positions = reduce_observation_times<Time, Profit>(
+                    observable_observation_times,
+                    observable_profits,
+                    observation_time_reduction_);
+            instance_.number_of_removed_observation_times_
+                += observable_observation_times.size() - positions.size();
+            Observable& observable = instance_.observables_[night_id][observable_id];
+            observable.observation_times_start = instance_.observation_times_.size();
+            observable.number_of_observation_times = positions.size();
+            for (Counter observation_time_pos: positions) {
+                instance_.observation_times_.push_back(observable_observation_times[observation_time_pos]);
+                instance_.profits_.push_back(observable_profits[observation_time_pos]);
+            }
+        }
+    }
+
+    // Store the observation time intervals observable by observable.
+    owners.clear();
+    for (const auto& p: observation_time_interval_observables_)
+        owners.push_back(night_starts[p.first] + p.second);
+    sorted_positions = group_by_owner(
+            owners,
+            instance_.number_of_observables_,
+            starts);
+    instance_.observation_time_intervals_.reserve(observation_time_intervals_.size());
+    for (NightId night_id = 0;
+            night_id < instance_.number_of_nights();
+            ++night_id) {
+        for (ObservableId observable_id = 0;
+                observable_id < instance_.number_of_observables(night_id);
+                ++observable_id) {
+            ObservableId owner = night_starts[night_id] + observable_id;
+            Observable& observable = instance_.observables_[night_id][observable_id];
+            observable.observation_time_intervals_start = starts[owner];
+            observable.number_of_observation_time_intervals = starts[owner + 1] - starts[owner];
+            for (Counter pos = starts[owner];
+                    pos < starts[owner + 1];
+                    ++pos) {
+                instance_.observation_time_intervals_.push_back(
+                        observation_time_intervals_[sorted_positions[pos]]);
+            }
+        }
+    }
+
+    // Compute maximum_profit for each observable and profit_sum_.
+    for (NightId night_id = 0;
+            night_id < instance_.number_of_nights();
+            ++night_id) {
+        for (ObservableId observable_id = 0;
+                observable_id < instance_.number_of_observables(night_id);
+                ++observable_id) {
+            Observable& observable = instance_.observables_[night_id][observable_id];
+            for (Profit profit: instance_.profits(night_id, observable_id))
+                observable.maximum_profit = std::max(observable.maximum_profit, profit);
+            for (const ObservationTimeInterval& interval: instance_.observation_time_intervals(night_id, observable_id)) {
+                observable.maximum_profit = std::max({
                         observable.maximum_profit,
-                        observable.profits[pos]);
+                        interval.observation_time_profit(interval.minimum_observation_time),
+                        interval.observation_time_profit(interval.maximum_observation_time)});
             }
-            instance_.profit_sum_ += observable.maximum_profit;;
+            instance_.profit_sum_ += observable.maximum_profit;
         }
     }
 
@@ -76,6 +76,8 @@ int main(int argc, char *argv[])
         ("only-write-at-the-end,e", "only write output and certificate files at the end")
         ("log,l", po::value<std::string>(), "set log file")
         ("log-to-stderr", "write log to stderr")
+        ("observation-time-reduction,", po::value<starobservationschedulingsolver::ObservationTimeReduction>(), "set the reduction of the observation times (none, dominance, concave-hull)")
+        ("reduction,", "reduce the instance before solving it")
 
         ("maximum-number-of-iterations,", po::value<int>(), "set the maximum number of iterations")
         ("maximum-number-of-iterations-without-improvement,", po::value<int>(), "set the maximum number of iterations without improvement")
@@ -95,6 +97,10 @@ int main(int argc, char *argv[])
 
     // Build instance.
     InstanceBuilder instance_builder;
+    if (vm.count("observation-time-reduction"))
+        instance_builder.set_observation_time_reduction(vm["observation-time-reduction"].as<starobservationschedulingsolver::ObservationTimeReduction>());
+    if (vm.count("reduction"))
+        instance_builder.set_reduction(true);
     instance_builder.read(
             vm["input"].as<std::string>(),
             vm["format"].as<std::string>());
@@ -18,7 +18,47 @@ void Solution::append_observation(
         Time start_time)
 {
     const Observable& observable = instance().observable(night_id, observable_id);
-    Time observation_time = observable.observation_times[observation_time_pos];
+    if (observation_time_pos >= observable.number_of_observation_times) {
+        throw std::invalid_argument(
+                "flexible_star_observation_scheduling::Solution::append_observation\n"
+                "Observation time position " + std::to_string(observation_time_pos)
+                + " of observable " + std::to_string(observable_id)
+                + " of night " + std::to_string(night_id)
+                + " is an observation time interval; its observation time must be given.");
+    }
+    append_observation(
+            night_id,
+            observable_id,
+            observation_time_pos,
+            instance().observation_times(night_id, observable_id)[observation_time_pos],
+            start_time);
+}
+
+void Solution::append_observation(
+        NightId night_id,
+        ObservableId observable_id,
+        Counter observation_time_pos,
+        Time observation_time,
+        Time start_time)
+{
+    const Observable& observable = instance().observable(night_id, observable_id);
+    Profit profit = 0;
+    if (observation_time_pos < observable.number_of_observation_times) {
+        if (observation_time != instance().observation_times(night_id, observable_id)[observation_time_pos]) {
+            throw std::runtime_error(
+                    "observation_time != instance().observation_times(night_id, observable_id)[observation_time_pos]");
+        }
+        profit = instance().profits(night_id, observable_id)[observation_time_pos];
+    } else {
+        const ObservationTimeInterval& interval = instance().observation_time_intervals(night_id, observable_id)[
+            observation_time_pos - observable.number_of_observation_times];
+        if (observation_time < interval.minimum_observation_time
+                || observation_time > interval.maximum_observation_time) {
+            throw std::runtime_error(
+                    "observation_time not in the observation time interval");
+        }
+        profit = interval.observation_time_profit(observation_time);
+    }
     SolutionNight& night = nights_[night_id];
     if (observable.release_date > start_time) {
         throw std::runtime_error(
@@ -49,12 +89,14 @@ void Solution::append_observation(
     observation.observable_id = observable_id;
     observation.start_time = start_time;
     observation.observation_time_pos = observation_time_pos;
+    observation.observation_time = observation_time;
+    observation.profit = profit;
     night.observations.push_back(observation);
 
     night.current_time = start_time + observation_time;
     targets_[observable.target_id] = 1;
     number_of_observations_++;
-    profit_ += observable.profits[observation_time_pos];
+    profit_ += profit;
 }
 
 std::ostream& Solution::format(
@@ -97,7 +139,7 @@ std::ostream& Solution::format(
                     << std::setw(12) << observable.target_id
                     << std::setw(12) << observation.observation_time_pos
                     << std::setw(12) << observation.start_time
-                    << std::setw(12) << observation.start_time + observable.observation_times[observation.observation_time_pos]
+                    << std::setw(12) << observation.start_time + observation.observation_time
                     << std::endl;
             }
         }
@@ -135,11 +177,11 @@ void Solution::write(
         file << night.observations.size() << std::endl;
         for (const auto& observation: night.observations) {
             const Observable& observable = instance().observable(night_id, observation.observable_id);
-            file << observation.observable_id
-                << " " << instance().observable(night_id, observation.observable_id).target_id
+            file << instance().original_observable_id(night_id, observation.observable_id)
+                << " " << instance().original_target_id(observable.target_id)
                 << " " << observation.start_time
-                << " " << observation.start_time + observable.observation_times[observation.observation_time_pos]
-                << " " << observable.profits[observation.observation_time_pos] / observable.maximum_profit
+                << " " << observation.start_time + observation.observation_time
+                << " " << observation.profit / observable.maximum_profit
                 << std::endl;
         }
     }
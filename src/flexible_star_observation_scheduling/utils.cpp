@@ -30,7 +30,7 @@ Instance starobservationschedulingsolver::flexible_star_observation_scheduling::
             // Add shorter observation time.
             for (double coef: coefs) {
                 Time reduced_observation_time = std::round(coef * observable.observation_time);
-                Profit reduced_profit = sosp_instance.target(observable.target_id).profit
+                Profit reduced_profit = (Profit)sosp_instance.target(observable.target_id).profit
                     * reduced_observation_time
                     / observable.observation_time;
                 instance_builder.add_observation_time(
@@ -75,20 +75,18 @@ Instance starobservationschedulingsolver::flexible_star_observation_scheduling::
                     observable.meridian,
                     observable.deadline);
 
-            // Add shorter observation time.
+            // Add the interval of observation times. The profit is
+            // proportional to the observation time.
             Time observation_time_min = std::round(coef * observable.observation_time);
-            for (Time observation_time = observation_time_min;
-                    observation_time <= observable.observation_time;
-                    ++observation_time) {
-                Profit profit = sosp_instance.target(observable.target_id).profit
-                    * observation_time
-                    / observable.observation_time;
-                instance_builder.add_observation_time(
-                        night_id,
-                        observable_id,
-                        observation_time,
-                        profit);
-            }
+            Profit profit_slope = (Profit)sosp_instance.target(observable.target_id).profit
+                / observable.observation_time;
+            instance_builder.add_observation_time_interval(
+                    night_id,
+                    observable_id,
+                    observation_time_min,
+                    observable.observation_time,
+                    profit_slope * observation_time_min,
+                    profit_slope);
         }
     }
 
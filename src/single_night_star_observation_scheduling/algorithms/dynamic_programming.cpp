@@ -2,143 +2,1412 @@
 
 #include "starobservationschedulingsolver/single_night_star_observation_scheduling/algorithm_formatter.hpp"
 
+#include "starobservationschedulingsolver/utils/night_segments.hpp"
+#include "starobservationschedulingsolver/utils/thread_pool.hpp"
+
+#include <cmath>
+#include <array>
+
 using namespace starobservationschedulingsolver::single_night_star_observation_scheduling;
 
 namespace
 {
 
-struct DynamicProgrammingState
+/**
+ * Compute the states of the next stage at the end of 'destination' and
+ * return the start of the next stage.
+ *
+ * The states of the next stage are the states of the current stage and the
+ * states of the current stage extended with the current target. The states
+ * of the current stage are the states 'stage_start' to 'stage_end' of
+ * 'states'; 'destination' may be 'states'.
+ */
+StateId compute_stage(
+        const starobservationschedulingsolver::ParetoStates& states,
+        starobservationschedulingsolver::ParetoStates& destination,
+        starobservationschedulingsolver::ParetoStageBuffers& buffers,
+        StateId stage_start,
+        StateId stage_end,
+        Time release_date,
+        Time deadline,
+        Time observation_time,
+        Profit profit,
+        TargetId target_pos)
+{
+    // A target has a single option, so the loop over the options of
+    // 'compute_pareto_stage' is removed at compile time.
+    std::array<starobservationschedulingsolver::ParetoOption, 1> options;
+    options[0].release_date = release_date;
+    options[0].latest_start = std::numeric_limits<Time>::max();
+    options[0].deadline = deadline;
+    options[0].observation_time = observation_time;
+    options[0].profit = profit;
+    options[0].label = target_pos;
+    StateId next_stage_start = starobservationschedulingsolver::compute_pareto_stage(
+            states,
+            stage_start,
+            stage_end,
+            options,
+            buffers,
+            destination);
+    if (destination.size > std::numeric_limits<StateId>::max()) {
+        throw std::runtime_error(
+                "single_night_star_observation_scheduling::DynamicProgrammingSolver::solve\n"
+                "Too many states.");
+    }
+    return next_stage_start;
+}
+
+/**
+ * Solve each segment of a night with its own solver and return the profit
+ * of the concatenation of their best schedules.
+ *
+ * The observations, the bound and the guarantee of the night are the
+ * concatenation of the observations, the sum of the bounds and the minimum
+ * of the guarantees of the segments.
+ *
+ * The profit of the targets of positive profit of a segment is an upper
+ * bound on the profit of its schedules. So, if a segment has no schedule of
+ * profit greater than 'threshold' minus these upper bounds for the other
+ * segments, the night has no schedule of profit greater than 'threshold'.
+ * Then, as with a single solver, the profit is 0 and the observations are
+ * empty.
+ */
+Profit solve_segments(
+        const Instance& instance,
+        const DynamicProgrammingOptionalParameters& parameters,
+        Profit threshold,
+        const std::vector<int64_t>& segment_ids,
+        int64_t number_of_segments,
+        std::vector<Observation>& observations,
+        Profit& bound,
+        double& guarantee)
+{
+    // The targets of a segment keep their relative order, so the segment
+    // solvers process them in the same order as a solver of the whole night.
+    std::vector<DynamicProgrammingSolver> solvers(number_of_segments);
+    std::vector<std::vector<TargetId>> segment_targets(number_of_segments);
+    std::vector<Profit> segment_profits(number_of_segments, 0);
+    Profit total_profit = 0;
+    for (TargetId target_id = 0;
+            target_id < instance.number_of_targets();
+            ++target_id) {
+        const Target& target = instance.target(target_id);
+        int64_t segment_id = segment_ids[target_id];
+        segment_targets[segment_id].push_back(target_id);
+        if (target.profit > 0) {
+            segment_profits[segment_id] += target.profit;
+            total_profit += target.profit;
+        }
+        solvers[segment_id].add_target(
+                target.release_date,
+                target.meridian,
+                target.deadline,
+                target.observation_time,
+                target.profit);
+    }
+
+    // The maximum number of states is shared between the segments
+    // proportionally to their number of targets.
+    for (int64_t segment_id = 0;
+            segment_id < number_of_segments;
+            ++segment_id) {
+        DynamicProgrammingSolver& solver = solvers[segment_id];
+        solver.set_engine(parameters.engine);
+        solver.set_storage(parameters.storage);
+        solver.set_threshold(threshold - (total_profit - segment_profits[segment_id]));
+        solver.set_epsilon(parameters.epsilon);
+        if (parameters.maximum_number_of_states < std::numeric_limits<Counter>::max()) {
+            solver.set_maximum_number_of_states((std::max)((Counter)1,
+                        (Counter)((double)parameters.maximum_number_of_states
+                            * segment_targets[segment_id].size()
+                            / instance.number_of_targets())));
+        }
+    }
+
+    starobservationschedulingsolver::ThreadPool thread_pool(parameters.number_of_threads);
+    thread_pool.run(
+            number_of_segments,
+            [&solvers](int64_t segment_id)
+            {
+                solvers[segment_id].solve();
+            });
+
+    Profit profit = 0;
+    bound = 0;
+    guarantee = 1;
+    bool stopped_early = false;
+    observations.clear();
+    for (int64_t segment_id = 0;
+            segment_id < number_of_segments;
+            ++segment_id) {
+        const DynamicProgrammingSolver& solver = solvers[segment_id];
+        profit += solver.profit();
+        bound += solver.bound();
+        guarantee = (std::min)(guarantee, solver.guarantee());
+        if (solver.stopped_early())
+            stopped_early = true;
+        for (Observation observation: solver.observations()) {
+            observation.target_id = segment_targets[segment_id][observation.target_id];
+            observations.push_back(observation);
+        }
+    }
+    if (stopped_early) {
+        observations.clear();
+        return 0;
+    }
+    return profit;
+}
+
+}
+
+std::istream& starobservationschedulingsolver::single_night_star_observation_scheduling::operator>>(
+        std::istream& in,
+        DynamicProgrammingEngine& engine)
 {
-    Time time;
-    Profit profit;
-    TargetId target_id;
-    DynamicProgrammingState* prev;
-};
+    std::string token;
+    in >> token;
+    if (token == "auto") {
+        engine = DynamicProgrammingEngine::Auto;
+    } else if (token == "pareto") {
+        engine = DynamicProgrammingEngine::Pareto;
+    } else if (token == "time-indexed") {
+        engine = DynamicProgrammingEngine::TimeIndexed;
+    } else if (token == "unicost") {
+        engine = DynamicProgrammingEngine::Unicost;
+    } else if (token == "interval-scheduling") {
+        engine = DynamicProgrammingEngine::IntervalScheduling;
+    } else  {
+        in.setstate(std::ios_base::failbit);
+    }
+    return in;
+}
 
-/*
-inline std::ostream& operator<<(
+std::ostream& starobservationschedulingsolver::single_night_star_observation_scheduling::operator<<(
         std::ostream& os,
-        const DynamicProgrammingState& s)
+        DynamicProgrammingEngine engine)
 {
-    os << "time " << s.time << " profit " << s.profit;
+    switch (engine) {
+    case DynamicProgrammingEngine::Auto: {
+        os << "auto";
+        break;
+    } case DynamicProgrammingEngine::Pareto: {
+        os << "pareto";
+        break;
+    } case DynamicProgrammingEngine::TimeIndexed: {
+        os << "time-indexed";
+        break;
+    } case DynamicProgrammingEngine::Unicost: {
+        os << "unicost";
+        break;
+    } case DynamicProgrammingEngine::IntervalScheduling: {
+        os << "interval-scheduling";
+        break;
+    }
+    }
     return os;
 }
-*/
 
+std::istream& starobservationschedulingsolver::single_night_star_observation_scheduling::operator>>(
+        std::istream& in,
+        DynamicProgrammingStorage& storage)
+{
+    std::string token;
+    in >> token;
+    if (token == "all-stages") {
+        storage = DynamicProgrammingStorage::AllStages;
+    } else if (token == "value-only") {
+        storage = DynamicProgrammingStorage::ValueOnly;
+    } else if (token == "checkpoints") {
+        storage = DynamicProgrammingStorage::Checkpoints;
+    } else  {
+        in.setstate(std::ios_base::failbit);
+    }
+    return in;
 }
 
-const Output starobservationschedulingsolver::single_night_star_observation_scheduling::dynamic_programming(
-        const Instance& instance,
-        const DynamicProgrammingOptionalParameters& parameters)
+std::ostream& starobservationschedulingsolver::single_night_star_observation_scheduling::operator<<(
+        std::ostream& os,
+        DynamicProgrammingStorage storage)
 {
-    Output output(instance);
-    AlgorithmFormatter algorithm_formatter(parameters, output);
-    algorithm_formatter.start("Dynamic programming");
-    algorithm_formatter.print_header();
+    switch (storage) {
+    case DynamicProgrammingStorage::AllStages: {
+        os << "all-stages";
+        break;
+    } case DynamicProgrammingStorage::ValueOnly: {
+        os << "value-only";
+        break;
+    } case DynamicProgrammingStorage::Checkpoints: {
+        os << "checkpoints";
+        break;
+    }
+    }
+    return os;
+}
 
-    Solution solution(instance);
-    //std::cout << "n " << n << std::endl;
-    //for (TargetId j = 0; j < n; ++j)
-    //    std::cout << "j " << j
-    //        << " w " << instance.target(j).profit
-    //        << " r " << instance.target(j).r
-    //        << " d " << instance.target(j).d
-    //        << " p " << instance.target(j).p
-    //        << std::endl;
-
-    // Sort targets.
-    std::vector<TargetId> sorted_targets(instance.number_of_targets());
-    std::iota(sorted_targets.begin(), sorted_targets.end(), 0);
+DynamicProgrammingEngine starobservationschedulingsolver::single_night_star_observation_scheduling::select_dynamic_programming_engine(
+        Time horizon,
+        TargetId number_of_targets)
+{
+    if (horizon <= 10 * number_of_targets)
+        return DynamicProgrammingEngine::TimeIndexed;
+    return DynamicProgrammingEngine::Pareto;
+}
+
+void DynamicProgrammingSolver::clear()
+{
+    sorted_targets_.clear();
+    positions_.clear();
+    release_dates_.clear();
+    meridians_.clear();
+    deadlines_.clear();
+    observation_times_.clear();
+    profits_.clear();
+    sorted_ = true;
+    earliest_release_date_ = std::numeric_limits<Time>::max();
+    latest_deadline_ = std::numeric_limits<Time>::min();
+
+    states_.size = 0;
+    states_.push_back(0, 0, -1, -1);
+    stage_starts_.assign(1, 0);
+    stage_ends_.assign(1, 1);
+    stage_guarantees_.assign(1, 1);
+    first_changed_pos_ = 0;
+    profit_ = 0;
+    guarantee_ = 1;
+    observations_.clear();
+    time_indexed_up_to_date_ = false;
+    unicost_up_to_date_ = false;
+    interval_scheduling_up_to_date_ = false;
+    interval_order_up_to_date_ = false;
+    light_up_to_date_ = false;
+}
+
+TargetId DynamicProgrammingSolver::add_target(
+        Time release_date,
+        Time meridian,
+        Time deadline,
+        Time observation_time,
+        Profit profit)
+{
+    TargetId target_id = sorted_targets_.size();
+    sorted_targets_.push_back(target_id);
+    positions_.push_back(target_id);
+    release_dates_.push_back(release_date);
+    meridians_.push_back(meridian);
+    deadlines_.push_back(deadline);
+    observation_times_.push_back(observation_time);
+    profits_.push_back(profit);
+    stage_starts_.push_back(0);
+    stage_ends_.push_back(0);
+    stage_guarantees_.push_back(1);
+    if (target_id > 0 && meridian < meridians_[target_id - 1])
+        sorted_ = false;
+    earliest_release_date_ = std::min(earliest_release_date_, release_date);
+    latest_deadline_ = std::max(latest_deadline_, deadline);
+    first_changed_pos_ = 0;
+    time_indexed_up_to_date_ = false;
+    unicost_up_to_date_ = false;
+    interval_scheduling_up_to_date_ = false;
+    interval_order_up_to_date_ = false;
+    light_up_to_date_ = false;
+    return target_id;
+}
+
+void DynamicProgrammingSolver::set_instance(
+        const Instance& instance)
+{
+    clear();
+    for (TargetId target_id = 0;
+            target_id < instance.number_of_targets();
+            ++target_id) {
+        const Target& target = instance.target(target_id);
+        add_target(
+                target.release_date,
+                target.meridian,
+                target.deadline,
+                target.observation_time,
+                target.profit);
+    }
+}
+
+void DynamicProgrammingSolver::sort_targets()
+{
+    TargetId number_of_targets = sorted_targets_.size();
+
+    // Compute the new order of the current positions.
+    std::vector<TargetId> order(number_of_targets);
+    std::iota(order.begin(), order.end(), 0);
     sort(
-            sorted_targets.begin(),
-            sorted_targets.end(),
-            [&instance](TargetId target_id_1, TargetId target_id_2) -> bool
+            order.begin(),
+            order.end(),
+            [this](TargetId target_pos_1, TargetId target_pos_2) -> bool
             {
-                return instance.target(target_id_1).meridian
-                    < instance.target(target_id_2).meridian;
+                if (meridians_[target_pos_1] != meridians_[target_pos_2])
+                    return meridians_[target_pos_1] < meridians_[target_pos_2];
+                return sorted_targets_[target_pos_1] < sorted_targets_[target_pos_2];
             });
 
+    // Permute target data.
+    auto permute = [&order](auto& values)
+    {
+        auto values_old = values;
+        for (TargetId target_pos = 0;
+                target_pos < (TargetId)order.size();
+                ++target_pos) {
+            values[target_pos] = values_old[order[target_pos]];
+        }
+    };
+    permute(sorted_targets_);
+    permute(release_dates_);
+    permute(meridians_);
+    permute(deadlines_);
+    permute(observation_times_);
+    permute(profits_);
+    for (TargetId target_pos = 0;
+            target_pos < number_of_targets;
+            ++target_pos) {
+        positions_[sorted_targets_[target_pos]] = target_pos;
+    }
+
+    sorted_ = true;
+    first_changed_pos_ = 0;
+    time_indexed_up_to_date_ = false;
+    unicost_up_to_date_ = false;
+    interval_scheduling_up_to_date_ = false;
+    interval_order_up_to_date_ = false;
+    light_up_to_date_ = false;
+}
+
+Profit DynamicProgrammingSolver::solve()
+{
+    if (!sorted_)
+        sort_targets();
+    if (threshold_ != -std::numeric_limits<Profit>::infinity())
+        compute_suffix_bounds();
+    if (approximate())
+        compute_trim_parameters();
+
+    if (storage_ != DynamicProgrammingStorage::AllStages) {
+        solve_pareto_light();
+        return profit_;
+    }
+
+    DynamicProgrammingEngine engine = engine_;
+    if (engine == DynamicProgrammingEngine::Auto) {
+        if (has_rigid_windows()) {
+            engine = DynamicProgrammingEngine::IntervalScheduling;
+        } else if (has_unit_profits()) {
+            engine = DynamicProgrammingEngine::Unicost;
+        } else {
+            engine = select_dynamic_programming_engine(
+                    horizon(),
+                    number_of_targets());
+        }
+    }
+    if (engine == DynamicProgrammingEngine::TimeIndexed) {
+        guarantee_ = 1;
+        solve_time_indexed();
+    } else if (engine == DynamicProgrammingEngine::Unicost) {
+        guarantee_ = 1;
+        solve_unicost();
+    } else if (engine == DynamicProgrammingEngine::IntervalScheduling) {
+        guarantee_ = 1;
+        solve_interval_scheduling();
+    } else {
+        solve_pareto();
+    }
+    return profit_;
+}
+
+void DynamicProgrammingSolver::compute_suffix_bounds()
+{
+    TargetId number_of_targets = sorted_targets_.size();
+    suffix_profits_.resize(number_of_targets + 1);
+    suffix_densities_.resize(number_of_targets + 1);
+    suffix_release_dates_.resize(number_of_targets + 1);
+    suffix_deadlines_.resize(number_of_targets + 1);
+    suffix_profits_[number_of_targets] = 0;
+    suffix_densities_[number_of_targets] = 0;
+    suffix_release_dates_[number_of_targets] = std::numeric_limits<Time>::max();
+    suffix_deadlines_[number_of_targets] = std::numeric_limits<Time>::min();
+    for (TargetId target_pos = number_of_targets - 1;
+            target_pos >= 0;
+            --target_pos) {
+        suffix_profits_[target_pos] = suffix_profits_[target_pos + 1];
+        suffix_densities_[target_pos] = suffix_densities_[target_pos + 1];
+        suffix_release_dates_[target_pos] = suffix_release_dates_[target_pos + 1];
+        suffix_deadlines_[target_pos] = suffix_deadlines_[target_pos + 1];
+        Profit profit = profits_[target_pos];
+        if (profit <= 0)
+            continue;
+        suffix_profits_[target_pos] += profit;
+        suffix_densities_[target_pos] = (observation_times_[target_pos] <= 0)?
+            std::numeric_limits<Profit>::infinity():
+            std::max(
+                    suffix_densities_[target_pos],
+                    profit / observation_times_[target_pos]);
+        suffix_release_dates_[target_pos] = std::min(
+                suffix_release_dates_[target_pos],
+                release_dates_[target_pos]);
+        suffix_deadlines_[target_pos] = std::max(
+                suffix_deadlines_[target_pos],
+                deadlines_[target_pos]);
+    }
+}
+
+void DynamicProgrammingSolver::compute_trim_parameters()
+{
+    TargetId number_of_targets = sorted_targets_.size();
+
+    // The factors of the stages along a schedule multiply, so the factor of
+    // a stage is the n-th root of the factor allowed by 'epsilon_'.
+    trim_factor_ = (number_of_targets == 0)?
+        1:
+        std::pow(1 - epsilon_, -1.0 / number_of_targets);
+
+    // The maximum number of states is shared between the stages kept in
+    // memory by the storage. With 'Checkpoints', these are the checkpoints,
+    // the stages of a segment and the current and next stages of the
+    // forward pass; see 'solve_pareto_light'.
+    if (maximum_number_of_states_ == std::numeric_limits<Counter>::max()) {
+        stage_maximum_number_of_states_ = std::numeric_limits<Counter>::max();
+        return;
+    }
+    Counter number_of_stages = 2;
+    if (storage_ == DynamicProgrammingStorage::AllStages) {
+        number_of_stages = number_of_targets + 1;
+    } else if (storage_ == DynamicProgrammingStorage::Checkpoints) {
+        TargetId checkpoint_interval = std::max(
+                (TargetId)1,
+                (TargetId)std::ceil(std::sqrt((double)number_of_targets)));
+        number_of_stages = (number_of_targets + checkpoint_interval - 1) / checkpoint_interval
+            + checkpoint_interval + 3;
+    }
+    stage_maximum_number_of_states_ = std::max(
+            (Counter)3,
+            maximum_number_of_states_ / number_of_stages);
+}
+
+void DynamicProgrammingSolver::prune_stage(
+        ParetoStates& states,
+        StateId stage_start,
+        TargetId target_pos) const
+{
+    StateId end = stage_start;
+    for (StateId state_id = stage_start; state_id < states.size; ++state_id) {
+        if (states.profits[state_id]
+                + suffix_bound(target_pos, states.times[state_id])
+                <= threshold_) {
+            continue;
+        }
+        states.times[end] = states.times[state_id];
+        states.profits[end] = states.profits[state_id];
+        states.prevs[end] = states.prevs[state_id];
+        states.labels[end] = states.labels[state_id];
+        end++;
+    }
+    states.size = end;
+}
+
+void DynamicProgrammingSolver::solve_pareto(bool exact)
+{
+    TargetId number_of_targets = sorted_targets_.size();
+    if (!sorted_)
+        sort_targets();
+    bool use_threshold = !exact
+        && (threshold_ != -std::numeric_limits<Profit>::infinity());
+
+    // Exact and approximate stages can't be mixed.
+    bool approximate = !exact && this->approximate();
+    if (approximate != approximate_stages_) {
+        first_changed_pos_ = 0;
+        approximate_stages_ = approximate;
+    }
+
+    // If no profit has changed, the previous solution is still optimal.
+    if (first_changed_pos_ == number_of_targets) {
+        guarantee_ = stage_guarantees_[number_of_targets];
+        return;
+    }
+    early_exit_ = false;
+
     // Compute states.
-    std::vector<std::vector<DynamicProgrammingState>> states(instance.number_of_targets() + 1);
-    states[0].push_back({0, 0, -1, nullptr});
+    // The stages up to 'first_changed_pos_' are kept.
+    states_.size = stage_ends_[first_changed_pos_];
+    for (TargetId target_pos = first_changed_pos_;
+            target_pos < number_of_targets;
+            ++target_pos) {
+        StateId stage_start = stage_starts_[target_pos];
+        StateId stage_end = stage_ends_[target_pos];
+
+        // Observing a target of non-positive profit never improves a
+        // schedule.
+        Profit profit = profits_[target_pos];
+        if (profit <= 0) {
+            stage_starts_[target_pos + 1] = stage_start;
+            stage_ends_[target_pos + 1] = stage_end;
+            stage_guarantees_[target_pos + 1] = stage_guarantees_[target_pos];
+            continue;
+        }
+
+        // Stop if no schedule can reach the threshold. The stages are
+        // complete up to this one, so the next call restarts from it.
+        if (use_threshold
+                && below_threshold(states_, stage_start, stage_end, target_pos)) {
+            first_changed_pos_ = target_pos;
+            early_exit_ = true;
+            profit_ = 0;
+            guarantee_ = stage_guarantees_[target_pos];
+            observations_.clear();
+            return;
+        }
+
+        StateId next_stage_start = compute_stage(
+                states_,
+                states_,
+                pareto_stage_buffers_,
+                stage_start,
+                stage_end,
+                release_dates_[target_pos],
+                deadlines_[target_pos],
+                observation_times_[target_pos],
+                profit,
+                target_pos);
+        double ratio = (approximate)? trim_stage(states_, next_stage_start): 1;
+        stage_starts_[target_pos + 1] = next_stage_start;
+        stage_ends_[target_pos + 1] = states_.size;
+        stage_guarantees_[target_pos + 1] = stage_guarantees_[target_pos] / ratio;
+    }
+
+    // Find best state.
+    // States of a stage are sorted by increasing profit.
+    StateId state_id_best = stage_ends_[number_of_targets] - 1;
+    profit_ = states_.profits[state_id_best];
+    guarantee_ = stage_guarantees_[number_of_targets];
+    //std::cout << "s_best t " << states_.times[state_id_best] << " profit " << profit_ << std::endl;
+
+    // Retrieve solution.
+    retrieve_observations(state_id_best, observations_);
+
+    first_changed_pos_ = number_of_targets;
+}
+
+void DynamicProgrammingSolver::solve_time_indexed()
+{
+    TargetId number_of_targets = sorted_targets_.size();
+    if (!sorted_)
+        sort_targets();
+
+    // If no profit has changed, the previous solution is still optimal.
+    if (time_indexed_up_to_date_)
+        return;
+    time_indexed_up_to_date_ = true;
+    early_exit_ = false;
+    bool use_threshold = (threshold_ != -std::numeric_limits<Profit>::infinity());
+
+    // Compute values.
+    // Times are relative to 'time_origin()'.
+    Time time_origin = this->time_origin();
+    Time horizon = this->horizon();
+    values_.assign(horizon + 1, 0);
+    extended_values_.resize(horizon + 1);
+    decisions_.clear();
+    decision_starts_.resize(number_of_targets);
+    decision_first_times_.resize(number_of_targets);
+    decision_last_times_.resize(number_of_targets);
     for (TargetId target_pos = 0;
-            target_pos < instance.number_of_targets();
+            target_pos < number_of_targets;
             ++target_pos) {
-        TargetId target_id = sorted_targets[target_pos];
-        const Target& target = instance.target(target_id);
-        //std::cout << "target_pos " << target_pos
-        //    << " target_id " << target_id
-        //    << " meridian " << target.meridian
-        //    << " states[target_pos].size() " << states[target_pos].size()
-        //    << std::endl;
-        auto it = states[target_pos].begin();
-        auto it1 = states[target_pos].begin();
-        while (it != states[target_pos].end() || it1 != states[target_pos].end()) {
-            if (it1 != states[target_pos].end()
-                    && (it == states[target_pos].end()
-                        || it->time > std::max(it1->time, target.release_date)
-                        + target.observation_time)) {
-                DynamicProgrammingState s1 {
-                        std::max(it1->time, target.release_date) + target.observation_time,
-                        it1->profit + target.profit,
-                        target_id,
-                        &(*it1) };
-                //std::cout << *it1 << " -> " << s1 << std::endl;
-                if (s1.time > target.deadline) {
-                    it1++;
-                    continue;
-                }
-
-                if (states[target_pos + 1].empty()
-                        || s1.profit > states[target_pos + 1].back().profit) {
-                    if (!states[target_pos + 1].empty()
-                            && s1.time == states[target_pos + 1].back().time) {
-                        states[target_pos + 1].back() = s1;
-                    } else {
-                        states[target_pos + 1].push_back(s1);
-                    }
-                }
-                it1++;
-            } else {
-                assert(it != states[target_pos].end());
-                //std::cout << *it << std::endl;
-                if (states[target_pos + 1].empty()
-                        || it->profit > states[target_pos + 1].back().profit) {
-                    if (!states[target_pos + 1].empty()
-                            && it->time == states[target_pos + 1].back().time) {
-                        states[target_pos + 1].back() = *it;
-                    } else {
-                        states[target_pos + 1].push_back(*it);
-                    }
-                }
-                ++it;
+        decision_starts_[target_pos] = decisions_.size();
+        decision_first_times_[target_pos] = 0;
+        decision_last_times_[target_pos] = -1;
+
+        // Observing a target of non-positive profit never improves a
+        // schedule.
+        Profit profit = profits_[target_pos];
+        if (profit <= 0)
+            continue;
+
+        // Stop if no schedule can reach the threshold. The values are
+        // non-decreasing, so the best one is the one of the horizon.
+        if (use_threshold
+                && values_[horizon] + suffix_bound(target_pos, time_origin) <= threshold_) {
+            early_exit_ = true;
+            profit_ = 0;
+            observations_.clear();
+            return;
+        }
+
+        Time observation_time = observation_times_[target_pos];
+        Time first_end = std::max(release_dates_[target_pos] - time_origin, (Time)0)
+            + observation_time;
+        Time last_end = std::min(deadlines_[target_pos] - time_origin, horizon);
+        if (first_end > last_end)
+            continue;
+
+        std::copy(
+                values_.begin() + first_end,
+                values_.begin() + last_end + 1,
+                extended_values_.begin() + first_end);
+        decisions_.resize(decisions_.size() + last_end - first_end + 1, 1);
+        starobservationschedulingsolver::extend_values(
+                values_.data(),
+                first_end,
+                last_end,
+                observation_time,
+                profit,
+                2,
+                extended_values_.data(),
+                decisions_.data() + decision_starts_[target_pos]);
+        decision_first_times_[target_pos] = first_end;
+        decision_last_times_[target_pos] = starobservationschedulingsolver::propagate_values(
+                values_.data(),
+                horizon,
+                extended_values_.data(),
+                first_end,
+                last_end,
+                decisions_,
+                decision_starts_[target_pos]);
+    }
+    profit_ = values_[horizon];
+
+    // Retrieve solution.
+    observations_.clear();
+    Time time = horizon;
+    for (TargetId target_pos = number_of_targets - 1;
+            target_pos >= 0;
+            --target_pos) {
+        Time first_time = decision_first_times_[target_pos];
+        Time last_time = decision_last_times_[target_pos];
+        if (time < first_time || time > last_time)
+            continue;
+        const uint8_t* decisions = decisions_.data() + decision_starts_[target_pos] - first_time;
+        while (time > first_time && decisions[time] == 0)
+            time--;
+        if (decisions[time] == 2) {
+            Time observation_time = observation_times_[target_pos];
+            Observation observation;
+            observation.target_id = sorted_targets_[target_pos];
+            observation.start_time = time_origin + time - observation_time;
+            observations_.push_back(observation);
+            time -= observation_time;
+        }
+    }
+    std::reverse(observations_.begin(), observations_.end());
+}
+
+bool DynamicProgrammingSolver::has_unit_profits() const
+{
+    Profit unit_profit = 0;
+    for (Profit profit: profits_) {
+        if (profit <= 0)
+            continue;
+        if (unit_profit == 0)
+            unit_profit = profit;
+        if (profit != unit_profit)
+            return false;
+    }
+    return true;
+}
+
+void DynamicProgrammingSolver::solve_unicost()
+{
+    TargetId number_of_targets = sorted_targets_.size();
+    if (!sorted_)
+        sort_targets();
+
+    // If no profit has changed, the previous solution is still optimal.
+    if (unicost_up_to_date_)
+        return;
+    early_exit_ = false;
+    bool use_threshold = (threshold_ != -std::numeric_limits<Profit>::infinity());
+
+    if (!has_unit_profits()) {
+        throw std::invalid_argument(
+                "single_night_star_observation_scheduling::DynamicProgrammingSolver::solve_unicost\n"
+                "The 'unicost' engine requires all the targets of positive "
+                "profit to have the same profit.");
+    }
+
+    // Compute earliest end times.
+    // 'last_count' is the number of observations of the best schedule.
+    count_times_.assign(number_of_targets + 2, std::numeric_limits<Time>::max());
+    count_times_[0] = 0;
+    extended_count_times_.assign(number_of_targets + 2, std::numeric_limits<Time>::max());
+    count_decisions_.clear();
+    count_decision_starts_.resize(number_of_targets + 1);
+    TargetId last_count = 0;
+    Profit unit_profit = 0;
+    for (TargetId target_pos = 0;
+            target_pos < number_of_targets;
+            ++target_pos) {
+        count_decision_starts_[target_pos] = count_decisions_.size();
+
+        // Observing a target of non-positive profit never improves a
+        // schedule.
+        Profit profit = profits_[target_pos];
+        if (profit <= 0)
+            continue;
+        unit_profit = profit;
+
+        // A target whose time window is shorter than its observation time
+        // can't be observed. Once such targets are skipped, a schedule
+        // ending before 'deadline - observation_time' can be extended with
+        // the target whatever its release date.
+        Time observation_time = observation_times_[target_pos];
+        if (release_dates_[target_pos] + observation_time > deadlines_[target_pos])
+            continue;
+
+        // Stop if no schedule can reach the threshold.
+        if (use_threshold
+                && last_count * profit + suffix_bound(target_pos, 0) <= threshold_) {
+            early_exit_ = true;
+            profit_ = 0;
+            observations_.clear();
+            unicost_up_to_date_ = true;
+            return;
+        }
+
+        // The schedules which can be extended with the target are the ones
+        // ending before 'deadline - observation_time'. They form a prefix
+        // since the end times are non-decreasing.
+        TargetId last_extended_count = std::upper_bound(
+                count_times_.begin(),
+                count_times_.begin() + last_count + 1,
+                deadlines_[target_pos] - observation_time)
+            - count_times_.begin() - 1;
+        if (last_extended_count < 0)
+            continue;
+
+        count_decisions_.resize(count_decisions_.size() + last_extended_count + 1);
+        std::copy(
+                count_times_.begin(),
+                count_times_.begin() + last_count + 2,
+                extended_count_times_.begin());
+        starobservationschedulingsolver::extend_counts(
+                count_times_.data(),
+                last_extended_count,
+                release_dates_[target_pos],
+                observation_time,
+                extended_count_times_.data(),
+                count_decisions_.data() + count_decision_starts_[target_pos]);
+        std::swap(count_times_, extended_count_times_);
+        if (last_extended_count == last_count)
+            last_count++;
+    }
+    count_decision_starts_[number_of_targets] = count_decisions_.size();
+    profit_ = last_count * unit_profit;
+
+    // Retrieve solution.
+    // The observed targets are retrieved backward, then their start times
+    // are computed forward.
+    observations_.clear();
+    TargetId count = last_count;
+    for (TargetId target_pos = number_of_targets - 1;
+            target_pos >= 0 && count > 0;
+            --target_pos) {
+        int64_t decision_start = count_decision_starts_[target_pos];
+        int64_t decision_end = count_decision_starts_[target_pos + 1];
+        if (count - 1 >= decision_end - decision_start
+                || count_decisions_[decision_start + count - 1] == 0) {
+            continue;
+        }
+        Observation observation;
+        observation.target_id = target_pos;
+        observations_.push_back(observation);
+        count--;
+    }
+    std::reverse(observations_.begin(), observations_.end());
+    Time time = 0;
+    for (Observation& observation: observations_) {
+        TargetId target_pos = observation.target_id;
+        observation.target_id = sorted_targets_[target_pos];
+        observation.start_time = std::max(time, release_dates_[target_pos]);
+        time = observation.start_time + observation_times_[target_pos];
+    }
+
+    unicost_up_to_date_ = true;
+}
+
+bool DynamicProgrammingSolver::has_rigid_windows() const
+{
+    for (TargetId target_pos = 0;
+            target_pos < (TargetId)profits_.size();
+            ++target_pos) {
+        if (profits_[target_pos] <= 0)
+            continue;
+        if (deadlines_[target_pos] - std::max((Time)0, release_dates_[target_pos])
+                > observation_times_[target_pos]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void DynamicProgrammingSolver::solve_interval_scheduling()
+{
+    TargetId number_of_targets = sorted_targets_.size();
+    if (!sorted_)
+        sort_targets();
+
+    // If no profit has changed, the previous solution is still optimal.
+    if (interval_scheduling_up_to_date_)
+        return;
+    early_exit_ = false;
+
+    if (!has_rigid_windows()) {
+        throw std::invalid_argument(
+                "single_night_star_observation_scheduling::DynamicProgrammingSolver::solve_interval_scheduling\n"
+                "The 'interval-scheduling' engine requires all the targets of "
+                "positive profit to have a rigid time window.");
+    }
+
+    // Sort the intervals.
+    // They only depend on the time windows, so they are kept between calls.
+    // The targets whose time window is shorter than their observation time
+    // can't be observed. An interval whose observation time is 0 ends at its
+    // start, so for equal end times, it comes after the other intervals and
+    // they are among its predecessors.
+    if (!interval_order_up_to_date_) {
+        interval_order_.clear();
+        for (TargetId target_pos = 0;
+                target_pos < number_of_targets;
+                ++target_pos) {
+            if (deadlines_[target_pos] - std::max((Time)0, release_dates_[target_pos])
+                    == observation_times_[target_pos]) {
+                interval_order_.push_back(target_pos);
             }
         }
+        std::sort(
+                interval_order_.begin(),
+                interval_order_.end(),
+                [this](TargetId target_pos_1, TargetId target_pos_2) -> bool
+                {
+                    if (deadlines_[target_pos_1] != deadlines_[target_pos_2])
+                        return deadlines_[target_pos_1] < deadlines_[target_pos_2];
+                    if (release_dates_[target_pos_1] != release_dates_[target_pos_2])
+                        return release_dates_[target_pos_1] < release_dates_[target_pos_2];
+                    return target_pos_1 < target_pos_2;
+                });
+        TargetId number_of_intervals = interval_order_.size();
+        interval_predecessors_.resize(number_of_intervals);
+        for (TargetId interval_pos = 0;
+                interval_pos < number_of_intervals;
+                ++interval_pos) {
+            Time start = std::max((Time)0, release_dates_[interval_order_[interval_pos]]);
+            TargetId number_of_predecessors = std::upper_bound(
+                    interval_order_.begin(),
+                    interval_order_.end(),
+                    start,
+                    [this](Time time, TargetId target_pos) -> bool
+                    {
+                        return time < deadlines_[target_pos];
+                    }) - interval_order_.begin();
+            interval_predecessors_[interval_pos] = std::min(
+                    interval_pos,
+                    number_of_predecessors);
+        }
+        interval_order_up_to_date_ = true;
     }
 
-    // Find best state.
-    const DynamicProgrammingState* s_best = nullptr;
-    for (const DynamicProgrammingState& s: states[instance.number_of_targets()])
-        if (s_best == nullptr || s_best->profit < s.profit)
-            s_best = &s;
-    //std::cout << "s_best t " << s_best.time << " profit " << s_best.profit << std::endl;
+    // Compute values.
+    TargetId number_of_intervals = interval_order_.size();
+    interval_values_.resize(number_of_intervals + 1);
+    interval_decisions_.resize(number_of_intervals);
+    interval_values_[0] = 0;
+    for (TargetId interval_pos = 0;
+            interval_pos < number_of_intervals;
+            ++interval_pos) {
+        Profit profit = profits_[interval_order_[interval_pos]];
+        Profit value = interval_values_[interval_predecessors_[interval_pos]] + profit;
+        bool observed = (profit > 0 && value > interval_values_[interval_pos]);
+        interval_values_[interval_pos + 1] = (observed)?
+            value:
+            interval_values_[interval_pos];
+        interval_decisions_[interval_pos] = observed;
+    }
+    profit_ = interval_values_[number_of_intervals];
 
     // Retrieve solution.
-    const DynamicProgrammingState* s_curr = s_best;
-    std::vector<const DynamicProgrammingState*> solution_states;
-    while (s_curr->prev != nullptr) {
-        solution_states.push_back(s_curr);
-        s_curr = s_curr->prev;
+    observations_.clear();
+    for (TargetId interval_pos = number_of_intervals - 1;
+            interval_pos >= 0;) {
+        if (!interval_decisions_[interval_pos]) {
+            interval_pos--;
+            continue;
+        }
+        TargetId target_pos = interval_order_[interval_pos];
+        Observation observation;
+        observation.target_id = sorted_targets_[target_pos];
+        observation.start_time = std::max((Time)0, release_dates_[target_pos]);
+        observations_.push_back(observation);
+        interval_pos = interval_predecessors_[interval_pos] - 1;
+    }
+    std::reverse(observations_.begin(), observations_.end());
+
+    interval_scheduling_up_to_date_ = true;
+}
+
+void DynamicProgrammingSolver::solve_pareto_light()
+{
+    TargetId number_of_targets = sorted_targets_.size();
+    if (!sorted_)
+        sort_targets();
+
+    // If no profit has changed, the previous solution is still optimal.
+    if (light_up_to_date_)
+        return;
+    light_up_to_date_ = true;
+    early_exit_ = false;
+    guarantee_ = 1;
+    bool use_threshold = (threshold_ != -std::numeric_limits<Profit>::infinity());
+    bool approximate = this->approximate();
+
+    bool checkpoints = (storage_ == DynamicProgrammingStorage::Checkpoints);
+    checkpoint_interval_ = std::max(
+            (TargetId)1,
+            (TargetId)std::ceil(std::sqrt((double)number_of_targets)));
+    checkpoints_.size = 0;
+    checkpoint_starts_.clear();
+
+    // Compute states.
+    // Only the current stage and the next one are kept, plus the checkpoints.
+    // With a threshold, the states which can't reach it are removed from
+    // each stage, and the computation stops if there is none left. With an
+    // approximation, the stages are trimmed after that. The segments are
+    // recomputed the same way, so that they end with the same states as the
+    // checkpoints.
+    ParetoStates* front = &fronts_[0];
+    ParetoStates* next_front = &fronts_[1];
+    front->size = 0;
+    front->push_back(0, 0, -1, -1);
+    if (use_threshold && below_threshold(*front, 0, 1, 0))
+        front->size = 0;
+    for (TargetId target_pos = 0;
+            target_pos < number_of_targets && front->size > 0;
+            ++target_pos) {
+        if (checkpoints && target_pos % checkpoint_interval_ == 0) {
+            checkpoint_starts_.push_back(checkpoints_.size);
+            for (StateId state_id = 0; state_id < front->size; ++state_id) {
+                checkpoints_.push_back(
+                        front->times[state_id],
+                        front->profits[state_id],
+                        -1,
+                        -1);
+            }
+        }
+
+        // Observing a target of non-positive profit never improves a
+        // schedule.
+        Profit profit = profits_[target_pos];
+        if (profit <= 0)
+            continue;
+
+        next_front->size = 0;
+        compute_stage(
+                *front,
+                *next_front,
+                pareto_stage_buffers_,
+                0,
+                front->size,
+                release_dates_[target_pos],
+                deadlines_[target_pos],
+                observation_times_[target_pos],
+                profit,
+                target_pos);
+        if (use_threshold)
+            prune_stage(*next_front, 0, target_pos + 1);
+        if (approximate)
+            guarantee_ /= trim_stage(*next_front, 0);
+        std::swap(front, next_front);
+    }
+    observations_.clear();
+    if (front->size == 0) {
+        early_exit_ = true;
+        profit_ = 0;
+        return;
     }
-    std::reverse(solution_states.begin(), solution_states.end());
-    for (const DynamicProgrammingState* state: solution_states) {
-        solution.append_observation(
-                state->target_id,
-                state->time - instance.target(state->target_id).observation_time);
+    checkpoint_starts_.push_back(checkpoints_.size);
+    profit_ = front->profits[front->size - 1];
+
+    // Retrieve solution.
+    // The segments between two checkpoints are recomputed from the last one
+    // to the first one. The last stage of a segment is the checkpoint at the
+    // start of the next segment, so the state reached at the start of the
+    // next segment is found at the same position in the last stage of the
+    // segment.
+    StateId checkpoint_state_pos = -1;
+    for (Counter checkpoint_pos = (Counter)checkpoint_starts_.size() - 2;
+            checkpoint_pos >= 0;
+            --checkpoint_pos) {
+        TargetId segment_start = checkpoint_pos * checkpoint_interval_;
+        TargetId segment_end = std::min(
+                number_of_targets,
+                segment_start + checkpoint_interval_);
+
+        segment_states_.size = 0;
+        for (StateId state_id = checkpoint_starts_[checkpoint_pos];
+                state_id < checkpoint_starts_[checkpoint_pos + 1];
+                ++state_id) {
+            segment_states_.push_back(
+                    checkpoints_.times[state_id],
+                    checkpoints_.profits[state_id],
+                    segment_states_.size,
+                    -1);
+        }
+        StateId stage_start = 0;
+        StateId stage_end = segment_states_.size;
+        for (TargetId target_pos = segment_start;
+                target_pos < segment_end;
+                ++target_pos) {
+            Profit profit = profits_[target_pos];
+            if (profit <= 0)
+                continue;
+            stage_start = compute_stage(
+                    segment_states_,
+                    segment_states_,
+                    pareto_stage_buffers_,
+                    stage_start,
+                    stage_end,
+                    release_dates_[target_pos],
+                    deadlines_[target_pos],
+                    observation_times_[target_pos],
+                    profit,
+                    target_pos);
+            if (use_threshold)
+                prune_stage(segment_states_, stage_start, target_pos + 1);
+            if (approximate)
+                trim_stage(segment_states_, stage_start);
+            stage_end = segment_states_.size;
+        }
+
+        StateId state_id = (checkpoint_state_pos == -1)?
+            stage_end - 1:
+            stage_start + checkpoint_state_pos;
+        for (;
+                segment_states_.labels[state_id] != -1;
+                state_id = segment_states_.prevs[state_id]) {
+            TargetId target_pos = segment_states_.labels[state_id];
+            Observation observation;
+            observation.target_id = sorted_targets_[target_pos];
+            observation.start_time = segment_states_.times[state_id] - observation_times_[target_pos];
+            observations_.push_back(observation);
+        }
+        checkpoint_state_pos = segment_states_.prevs[state_id];
+    }
+    std::reverse(observations_.begin(), observations_.end());
+}
+
+void DynamicProgrammingSolver::compute_marginal_values()
+{
+    solve_pareto(true);
+    TargetId number_of_targets = sorted_targets_.size();
+
+    // Backward pass.
+    // It is the forward pass on the reversed time axis: the release date of
+    // a target becomes the opposite of its deadline and its deadline the
+    // opposite of its release date.
+    backward_states_.size = 0;
+    backward_states_.push_back(std::numeric_limits<Time>::min(), 0, -1, -1);
+    backward_stage_starts_.resize(number_of_targets + 1);
+    backward_stage_ends_.resize(number_of_targets + 1);
+    backward_stage_starts_[number_of_targets] = 0;
+    backward_stage_ends_[number_of_targets] = 1;
+    for (TargetId target_pos = number_of_targets - 1;
+            target_pos >= 0;
+            --target_pos) {
+        StateId stage_start = backward_stage_starts_[target_pos + 1];
+        StateId stage_end = backward_stage_ends_[target_pos + 1];
+        Profit profit = profits_[target_pos];
+        if (profit <= 0) {
+            backward_stage_starts_[target_pos] = stage_start;
+            backward_stage_ends_[target_pos] = stage_end;
+            continue;
+        }
+        StateId next_stage_start = compute_stage(
+                backward_states_,
+                backward_states_,
+                pareto_stage_buffers_,
+                stage_start,
+                stage_end,
+                -deadlines_[target_pos],
+                -release_dates_[target_pos],
+                observation_times_[target_pos],
+                profit,
+                target_pos);
+        backward_stage_starts_[target_pos] = next_stage_start;
+        backward_stage_ends_[target_pos] = backward_states_.size;
+    }
+
+    // Combine the forward stage before each target with the backward stage
+    // after it.
+    // Forward states are sorted by increasing end time and profit. Backward
+    // states are sorted by decreasing latest free time and increasing profit.
+    // Thus, for a forward state, the best compatible backward state is the
+    // last one whose latest free time is greater than or equal to the end
+    // time of the forward state. It moves backward when the end time
+    // increases. The first backward state of each stage is the empty
+    // schedule, which is compatible with all forward states.
+    values_with_.resize(number_of_targets);
+    values_without_.resize(number_of_targets);
+    best_with_states_.resize(number_of_targets);
+    for (TargetId target_pos = 0;
+            target_pos < number_of_targets;
+            ++target_pos) {
+        StateId forward_start = stage_starts_[target_pos];
+        StateId forward_end = stage_ends_[target_pos];
+        StateId backward_end = backward_stage_ends_[target_pos + 1];
+        Time release_date = release_dates_[target_pos];
+        Time deadline = deadlines_[target_pos];
+        Time observation_time = observation_times_[target_pos];
+
+        // Without the target.
+        Profit value_without = 0;
+        StateId backward_state_id = backward_end - 1;
+        for (StateId forward_state_id = forward_start;
+                forward_state_id < forward_end;
+                ++forward_state_id) {
+            Time forward_time = states_.times[forward_state_id];
+            while (backward_states_.times[backward_state_id] > -forward_time)
+                backward_state_id--;
+            value_without = (std::max)(
+                    value_without,
+                    states_.profits[forward_state_id] + backward_states_.profits[backward_state_id]);
+        }
+        values_without_[target_pos] = value_without;
+
+        // With the target.
+        Profit value_with = -std::numeric_limits<Profit>::infinity();
+        best_with_states_[target_pos] = {-1, -1};
+        backward_state_id = backward_end - 1;
+        for (StateId forward_state_id = forward_start;
+                forward_state_id < forward_end;
+                ++forward_state_id) {
+            Time end = std::max(states_.times[forward_state_id], release_date) + observation_time;
+            if (end > deadline)
+                break;
+            while (backward_states_.times[backward_state_id] > -end)
+                backward_state_id--;
+            Profit value = states_.profits[forward_state_id]
+                + profits_[target_pos]
+                + backward_states_.profits[backward_state_id];
+            if (value > value_with) {
+                value_with = value;
+                best_with_states_[target_pos] = {forward_state_id, backward_state_id};
+            }
+        }
+        values_with_[target_pos] = value_with;
+    }
+}
+
+void DynamicProgrammingSolver::schedule_with(
+        TargetId target_id,
+        std::vector<Observation>& observations) const
+{
+    TargetId target_pos = positions_[target_id];
+    StateId forward_state_id = best_with_states_[target_pos].first;
+    StateId backward_state_id = best_with_states_[target_pos].second;
+    if (forward_state_id == -1) {
+        observations.clear();
+        return;
+    }
+
+    // Observations before the target.
+    retrieve_observations(forward_state_id, observations);
+
+    // Target.
+    Time time = std::max(states_.times[forward_state_id], release_dates_[target_pos]);
+    Observation observation;
+    observation.target_id = target_id;
+    observation.start_time = time;
+    observations.push_back(observation);
+    time += observation_times_[target_pos];
+
+    // Observations after the target.
+    // Backward states are linked from the first observation of their
+    // schedule to the last one. Each observation starts as soon as possible.
+    for (StateId state_id = backward_state_id;
+            backward_states_.prevs[state_id] != -1;
+            state_id = backward_states_.prevs[state_id]) {
+        TargetId next_target_pos = backward_states_.labels[state_id];
+        Observation observation;
+        observation.target_id = sorted_targets_[next_target_pos];
+        observation.start_time = std::max(time, release_dates_[next_target_pos]);
+        observations.push_back(observation);
+        time = observation.start_time + observation_times_[next_target_pos];
+    }
+}
+
+Counter DynamicProgrammingSolver::number_of_schedules() const
+{
+    if (early_exit_)
+        return 0;
+
+    // States of a stage are sorted by increasing profit, so the states of
+    // non-positive profit are at the start of the stage.
+    StateId stage_start = stage_starts_.back();
+    StateId stage_end = stage_ends_.back();
+    StateId state_id = stage_start;
+    while (state_id < stage_end && states_.profits[state_id] <= 0)
+        state_id++;
+    return stage_end - state_id;
+}
+
+void DynamicProgrammingSolver::retrieve_observations(
+        StateId state_id,
+        std::vector<Observation>& observations) const
+{
+    observations.clear();
+    for (;
+            states_.prevs[state_id] != -1;
+            state_id = states_.prevs[state_id]) {
+        TargetId target_pos = states_.labels[state_id];
+        Observation observation;
+        observation.target_id = sorted_targets_[target_pos];
+        observation.start_time = states_.times[state_id] - observation_times_[target_pos];
+        observations.push_back(observation);
+    }
+    std::reverse(observations.begin(), observations.end());
+}
+
+const DynamicProgrammingOutput starobservationschedulingsolver::single_night_star_observation_scheduling::dynamic_programming(
+        const Instance& instance,
+        const DynamicProgrammingOptionalParameters& parameters)
+{
+    DynamicProgrammingOutput output(instance);
+    AlgorithmFormatter algorithm_formatter(parameters, output);
+    algorithm_formatter.start("Dynamic programming");
+    algorithm_formatter.print_header();
+
+    // The threshold is raised to the profit of the incumbent.
+    Profit threshold = parameters.threshold;
+    if (parameters.incumbent != nullptr)
+        threshold = std::max(threshold, parameters.incumbent->profit());
+
+    // Split the night into independent segments.
+    std::vector<int64_t> segment_ids;
+    int64_t number_of_segments = 1;
+    if (parameters.segmentation
+            && parameters.number_of_solutions == 1
+            && !parameters.compute_marginal_values) {
+        std::vector<Time> release_dates;
+        std::vector<Time> meridians;
+        std::vector<Time> deadlines;
+        std::vector<Time> observation_times;
+        for (TargetId target_id = 0;
+                target_id < instance.number_of_targets();
+                ++target_id) {
+            const Target& target = instance.target(target_id);
+            release_dates.push_back(target.release_date);
+            meridians.push_back(target.meridian);
+            deadlines.push_back(target.deadline);
+            observation_times.push_back(target.observation_time);
+        }
+        number_of_segments = starobservationschedulingsolver::compute_night_segments(
+                release_dates,
+                meridians,
+                deadlines,
+                observation_times,
+                segment_ids);
+    }
+    if (number_of_segments > 1) {
+        std::vector<Observation> observations;
+        Profit bound = 0;
+        Profit profit = solve_segments(
+                instance,
+                parameters,
+                threshold,
+                segment_ids,
+                number_of_segments,
+                observations,
+                bound,
+                output.guarantee);
+
+        Solution solution(instance);
+        if (parameters.incumbent != nullptr && profit <= threshold) {
+            solution = *parameters.incumbent;
+        } else {
+            for (const Observation& observation: observations) {
+                solution.append_observation(
+                        observation.target_id,
+                        observation.start_time);
+            }
+        }
+        if (solution.profit() > 0)
+            output.solutions.push_back(solution);
+
+        algorithm_formatter.update_solution(solution, "");
+        algorithm_formatter.update_bound(bound, "");
+
+        algorithm_formatter.end();
+        return output;
+    }
+
+    // The other schedules of the last stage are only available with the
+    // Pareto engine.
+    DynamicProgrammingSolver solver;
+    solver.set_instance(instance);
+    if (parameters.number_of_solutions > 1) {
+        solver.set_engine(DynamicProgrammingEngine::Pareto);
+    } else {
+        solver.set_engine(parameters.engine);
+    }
+    if (parameters.number_of_solutions == 1
+            && !parameters.compute_marginal_values) {
+        solver.set_storage(parameters.storage);
+    }
+    solver.set_threshold(threshold);
+    solver.set_epsilon(parameters.epsilon);
+    solver.set_maximum_number_of_states(parameters.maximum_number_of_states);
+    solver.solve();
+    output.guarantee = solver.guarantee();
+
+    Solution solution(instance);
+    if (parameters.incumbent != nullptr && solver.profit() <= threshold) {
+        solution = *parameters.incumbent;
+    } else {
+        for (const Observation& observation: solver.observations()) {
+            solution.append_observation(
+                    observation.target_id,
+                    observation.start_time);
+        }
+    }
+
+    // Retrieve the other schedules of the last stage.
+    std::vector<Observation> observations;
+    if (parameters.number_of_solutions == 1 && solution.profit() > 0)
+        output.solutions.push_back(solution);
+    for (Counter schedule_pos = 0;
+            parameters.number_of_solutions > 1
+            && schedule_pos < solver.number_of_schedules()
+            && schedule_pos < parameters.number_of_solutions;
+            ++schedule_pos) {
+        solver.schedule_observations(schedule_pos, observations);
+        Solution schedule(instance);
+        for (const Observation& observation: observations) {
+            schedule.append_observation(
+                    observation.target_id,
+                    observation.start_time);
+        }
+        output.solutions.push_back(schedule);
+    }
+
+    // Compute marginal values.
+    if (parameters.compute_marginal_values) {
+        solver.compute_marginal_values();
+        output.values_with.resize(instance.number_of_targets());
+        output.values_without.resize(instance.number_of_targets());
+        for (TargetId target_id = 0;
+                target_id < instance.number_of_targets();
+                ++target_id) {
+            output.values_with[target_id] = solver.value_with(target_id);
+            output.values_without[target_id] = solver.value_without(target_id);
+        }
     }
 
     algorithm_formatter.update_solution(solution, "");
-    algorithm_formatter.update_bound(solution.profit(), "");
+    algorithm_formatter.update_bound(solver.bound(), "");
 
     algorithm_formatter.end();
     return output;
@@ -21,6 +21,12 @@ void InstanceBuilder::add_target(
     instance_.targets_.push_back(target);
 }
 
+void InstanceBuilder::set_unicost()
+{
+    for (Target& target: instance_.targets_)
+        target.profit = 1;
+}
+
 void InstanceBuilder::read(
         const std::string& instance_path,
         const std::string& format)
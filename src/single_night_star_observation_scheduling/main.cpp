@@ -49,6 +49,22 @@ Output run(
     if (algorithm == "dynamic-programming") {
         DynamicProgrammingOptionalParameters parameters;
         read_args(parameters, vm);
+        if (vm.count("engine"))
+            parameters.engine = vm["engine"].as<DynamicProgrammingEngine>();
+        if (vm.count("storage"))
+            parameters.storage = vm["storage"].as<DynamicProgrammingStorage>();
+        if (vm.count("number-of-solutions"))
+            parameters.number_of_solutions = vm["number-of-solutions"].as<Counter>();
+        parameters.compute_marginal_values = vm.count("compute-marginal-values");
+        if (vm.count("threshold"))
+            parameters.threshold = vm["threshold"].as<Profit>();
+        if (vm.count("epsilon"))
+            parameters.epsilon = vm["epsilon"].as<double>();
+        if (vm.count("maximum-number-of-states"))
+            parameters.maximum_number_of_states = vm["maximum-number-of-states"].as<Counter>();
+        parameters.segmentation = vm.count("segmentation");
+        if (vm.count("number-of-threads"))
+            parameters.number_of_threads = vm["number-of-threads"].as<Counter>();
         return dynamic_programming(instance, parameters);
 
     } else {
@@ -79,6 +95,15 @@ int main(int argc, char *argv[])
 
         ("maximum-number-of-iterations,", po::value<int>(), "set the maximum number of iterations")
         ("maximum-number-of-iterations-without-improvement,", po::value<int>(), "set the maximum number of iterations without improvement")
+        ("engine,", po::value<DynamicProgrammingEngine>(), "set the dynamic programming engine (auto, pareto, time-indexed, unicost, interval-scheduling)")
+        ("storage,", po::value<DynamicProgrammingStorage>(), "set the storage of the dynamic programming states (all-stages, value-only, checkpoints)")
+        ("number-of-solutions,", po::value<Counter>(), "set the number of solutions returned by the dynamic programming algorithm")
+        ("compute-marginal-values,", "compute the value of the best schedule with and without each target")
+        ("threshold,", po::value<Profit>(), "only search the schedules of profit greater than the threshold")
+        ("epsilon,", po::value<double>(), "set the relative accuracy of the dynamic programming algorithm")
+        ("maximum-number-of-states,", po::value<Counter>(), "set the maximum number of states of the dynamic programming algorithm")
+        ("segmentation,", "split the night into independent segments at the gaps between the time windows")
+        ("number-of-threads,", po::value<Counter>(), "set the number of threads used to solve the segments")
         ;
     po::variables_map vm;
     po::store(po::parse_command_line(argc, argv, desc), vm);
@@ -98,6 +123,8 @@ int main(int argc, char *argv[])
     instance_builder.read(
             vm["input"].as<std::string>(),
             vm["format"].as<std::string>());
+    if (vm.count("unicost"))
+        instance_builder.set_unicost();
     const Instance instance = instance_builder.build();
 
     // Run.
@@ -39,9 +39,11 @@
 
 #include "starobservationschedulingsolver/star_observation_scheduling/algorithm_formatter.hpp"
 
-#include "starobservationschedulingsolver/single_night_star_observation_scheduling/instance_builder.hpp"
 #include "starobservationschedulingsolver/single_night_star_observation_scheduling/algorithms/dynamic_programming.hpp"
 
+#include "starobservationschedulingsolver/utils/thread_pool.hpp"
+#include "starobservationschedulingsolver/utils/night_segments.hpp"
+
 #include "columngenerationsolver/commons.hpp"
 #include "columngenerationsolver/algorithms/greedy.hpp"
 
@@ -59,11 +61,9 @@ class PricingSolver: public columngenerationsolver::PricingSolver
 
 public:
 
-    PricingSolver(const Instance& instance):
-        instance_(instance),
-        fixed_targets_(instance.number_of_targets()),
-        fixed_nights_(instance.number_of_nights())
-    {  }
+    PricingSolver(
+            const Instance& instance,
+            const ColumnGenerationOptionalParameters& parameters);
 
     virtual std::vector<std::shared_ptr<const Column>> initialize_pricing(
             const std::vector<std::pair<std::shared_ptr<const Column>, Value>>& fixed_columns);
@@ -79,12 +79,166 @@ private:
 
     std::vector<int8_t> fixed_nights_;
 
-    std::vector<TargetId> snsosp2sosp_;
+    /**
+     * Subproblem solvers.
+     *
+     * Each night keeps its own solver so that its states are reused from one
+     * pricing call to the next one. The solver of a night contains all the
+     * observables of the night, in the same order. Fixed targets and targets
+     * of non-positive reduced profit are disabled by setting their profit to
+     * 0.
+     */
+    std::vector<starobservationschedulingsolver::single_night_star_observation_scheduling::DynamicProgrammingSolver> snsosp_solvers_;
+
+    /**
+     * Observables of the nights, stored as structures of arrays, if the
+     * instance doesn't store them.
+     */
+    std::vector<NightObservables> night_observables_;
+
+    /** Get the observables of a night, stored as a structure of arrays. */
+    const NightObservables& pricing_night_observables(NightId night_id) const
+    {
+        return (instance_.has_night_observables())?
+            instance_.night_observables(night_id):
+            night_observables_[night_id];
+    }
+
+    /** Thread pool used to price the nights concurrently. */
+    starobservationschedulingsolver::ThreadPool thread_pool_;
+
+    /** Maximum number of columns generated per night. */
+    Counter number_of_columns_per_night_ = 1;
+
+    /**
+     * 'true' iff the subproblems are first solved value-only, see
+     * 'ColumnGenerationOptionalParameters::value_only_pricing'.
+     */
+    bool value_only_pricing_ = false;
+
+    /**
+     * Relative accuracy of the approximate pricing, see
+     * 'ColumnGenerationOptionalParameters::pricing_epsilon'.
+     */
+    double pricing_epsilon_ = 0;
+
+    /** Maximum number of states of a subproblem during the approximate pricing. */
+    Counter pricing_maximum_number_of_states_ = std::numeric_limits<Counter>::max();
+
+    /**
+     * 'true' iff an approximate pricing of the current column generation has
+     * found no column.
+     *
+     * Then the column generation is close to convergence, and the next
+     * pricings are exact. Otherwise, the subproblems would switch between
+     * the approximate and the exact accuracies at each pricing, which
+     * restarts their dynamic programs from the first stage twice.
+     */
+    bool approximate_pricing_failed_ = false;
+
+    /**
+     * Segment subproblem solvers, see
+     * 'ColumnGenerationOptionalParameters::segmented_pricing'.
+     *
+     * The segments of night 'night_id' are the segments from
+     * 'night_segment_starts_[night_id]' to
+     * 'night_segment_starts_[night_id + 1]'. A night with a single segment
+     * is priced by its solver of 'snsosp_solvers_'.
+     */
+    std::vector<starobservationschedulingsolver::single_night_star_observation_scheduling::DynamicProgrammingSolver> segment_solvers_;
+
+    /** Start of the segments of each night. */
+    std::vector<Counter> night_segment_starts_;
+
+    /** Night of each segment. */
+    std::vector<NightId> segment_nights_;
+
+    /**
+     * Position of the first observable of each segment in the night
+     * observables of its night.
+     *
+     * The night observables are sorted by meridian, so the observables of a
+     * segment are consecutive. Target 'pos' of a segment solver is the
+     * observable at position 'segment_observable_starts_[segment_id] + pos'.
+     */
+    std::vector<ObservablePos> segment_observable_starts_;
+
+    /**
+     * Sum of the positive profits of the targets of each segment in the
+     * subproblems of the current pricing call.
+     *
+     * It bounds the profit of the schedules of the segment, see
+     * 'solve_pricing_segment'.
+     */
+    std::vector<starobservationschedulingsolver::single_night_star_observation_scheduling::Profit> segment_positive_profits_;
+
+    /**
+     * Pricing tasks run concurrently: a night with a single segment, as
+     * '(night_id, -1)', or a segment of a night, as '(night_id, segment_id)'.
+     */
+    std::vector<std::pair<NightId, Counter>> pricing_tasks_;
+
+    /** Columns generated for each night by the last pricing call. */
+    std::vector<std::vector<std::shared_ptr<const Column>>> night_columns_;
+
+    /**
+     * Upper bound on the reduced cost of the columns of each night computed
+     * by the last pricing call.
+     */
+    std::vector<Value> night_reduced_cost_bounds_;
+
+    /** Get the profit of an observable of a target in the subproblems. */
+    starobservationschedulingsolver::single_night_star_observation_scheduling::Profit target_profit(
+            TargetId target_id,
+            const std::vector<Value>& duals) const;
+
+    /**
+     * Price a night and store its columns in 'night_columns_'.
+     *
+     * If 'approximate' is 'true', the subproblem is solved with the accuracy
+     * of the approximate pricing.
+     */
+    void solve_pricing_night(
+            NightId night_id,
+            const std::vector<Value>& duals,
+            bool approximate);
+
+    /**
+     * Compute the sum of the positive profits of the targets of each
+     * segment and store it in 'segment_positive_profits_'.
+     */
+    void compute_segment_positive_profits(
+            const std::vector<Value>& duals);
+
+    /**
+     * Solve the subproblem of a segment.
+     *
+     * If 'approximate' is 'true', the subproblem is solved with the accuracy
+     * of the approximate pricing.
+     */
+    void solve_pricing_segment(
+            Counter segment_id,
+            const std::vector<Value>& duals,
+            bool approximate);
+
+    /**
+     * Build the column of a night with several segments from the schedules
+     * of its segments.
+     */
+    void collect_pricing_segments(
+            NightId night_id,
+            const std::vector<Value>& duals);
+
+    /** Build the column of a schedule of a night and add it to 'night_columns_'. */
+    void add_column(
+            NightId night_id,
+            const std::vector<starobservationschedulingsolver::single_night_star_observation_scheduling::Observation>& snsosp_observations);
 
 };
 
 columngenerationsolver::Model get_model(
-        const Instance& instance)
+        const Instance& instance,
+        const ColumnGenerationOptionalParameters& parameters)
 {
     columngenerationsolver::Model model;
 
@@ -116,16 +270,117 @@ columngenerationsolver::Model get_model(
 
     // Pricing solver.
     model.pricing_solver = std::unique_ptr<columngenerationsolver::PricingSolver>(
-            new PricingSolver(instance));
+            new PricingSolver(instance, parameters));
 
     return model;
 }
 
+PricingSolver::PricingSolver(
+        const Instance& instance,
+        const ColumnGenerationOptionalParameters& parameters):
+    instance_(instance),
+    fixed_targets_(instance.number_of_targets()),
+    fixed_nights_(instance.number_of_nights()),
+    snsosp_solvers_(instance.number_of_nights()),
+    thread_pool_(parameters.number_of_threads),
+    number_of_columns_per_night_(parameters.number_of_columns_per_night),
+    value_only_pricing_(parameters.value_only_pricing),
+    pricing_epsilon_(parameters.pricing_epsilon),
+    pricing_maximum_number_of_states_(parameters.pricing_maximum_number_of_states),
+    night_columns_(instance.number_of_nights()),
+    night_reduced_cost_bounds_(instance.number_of_nights(), 0)
+{
+    if (!instance_.has_night_observables()) {
+        night_observables_.reserve(instance_.number_of_nights());
+        for (NightId night_id = 0;
+                night_id < instance_.number_of_nights();
+                ++night_id) {
+            night_observables_.push_back(instance_.compute_night_observables(night_id));
+        }
+    }
+    night_segment_starts_.push_back(0);
+
+    // Add the observables of each night to its subproblem solver.
+    // The target of the subproblem has the id of the observable.
+    for (NightId night_id = 0;
+            night_id < instance_.number_of_nights();
+            ++night_id) {
+
+        // Split the night into segments. The other schedules of the last
+        // stage of a segment are not schedules of the night, so a night is
+        // only split if a single column is generated per night.
+        const NightObservables& night_observables = pricing_night_observables(night_id);
+        std::vector<int64_t> segment_ids;
+        int64_t number_of_segments = 1;
+        if (parameters.segmented_pricing && number_of_columns_per_night_ == 1) {
+            number_of_segments = starobservationschedulingsolver::compute_night_segments(
+                    night_observables.release_dates,
+                    night_observables.meridians,
+                    night_observables.deadlines,
+                    night_observables.observation_times,
+                    segment_ids);
+        }
+        if (number_of_segments > 1) {
+            Counter segment_start = segment_solvers_.size();
+            segment_solvers_.resize(segment_start + number_of_segments);
+            for (ObservablePos observable_pos = 0;
+                    observable_pos < (ObservablePos)night_observables.observable_ids.size();
+                    ++observable_pos) {
+                Counter segment_id = segment_start + segment_ids[observable_pos];
+                if (segment_id == (Counter)segment_nights_.size()) {
+                    segment_nights_.push_back(night_id);
+                    segment_observable_starts_.push_back(observable_pos);
+                    pricing_tasks_.push_back({night_id, segment_id});
+                }
+                segment_solvers_[segment_id].add_target(
+                        night_observables.release_dates[observable_pos],
+                        night_observables.meridians[observable_pos],
+                        night_observables.deadlines[observable_pos],
+                        night_observables.observation_times[observable_pos]);
+            }
+            for (Counter segment_id = segment_start;
+                    segment_id < (Counter)segment_solvers_.size();
+                    ++segment_id) {
+                segment_solvers_[segment_id].set_engine(
+                        starobservationschedulingsolver::single_night_star_observation_scheduling::DynamicProgrammingEngine::Auto);
+            }
+            night_segment_starts_.push_back(segment_solvers_.size());
+            continue;
+        }
+        night_segment_starts_.push_back(segment_solvers_.size());
+        pricing_tasks_.push_back({night_id, -1});
+
+        for (ObservableId observable_id = 0;
+                observable_id < (ObservableId)instance_.night(night_id).observables.size();
+                ++observable_id) {
+            const Observable& observable = instance_.observable(night_id, observable_id);
+            snsosp_solvers_[night_id].add_target(
+                    observable.release_date,
+                    observable.meridian,
+                    observable.deadline,
+                    observable.observation_time);
+        }
+
+        // The other schedules of the last stage are only available with the
+        // Pareto engine. Otherwise, the engine is selected from the length of
+        // the night and its number of observables.
+        if (number_of_columns_per_night_ > 1) {
+            snsosp_solvers_[night_id].set_engine(
+                    starobservationschedulingsolver::single_night_star_observation_scheduling::DynamicProgrammingEngine::Pareto);
+        } else {
+            snsosp_solvers_[night_id].set_engine(
+                    starobservationschedulingsolver::single_night_star_observation_scheduling::DynamicProgrammingEngine::Auto);
+        }
+    }
+    segment_positive_profits_.resize(segment_solvers_.size(), 0);
+}
+
 std::vector<std::shared_ptr<const Column>> PricingSolver::initialize_pricing(
             const std::vector<std::pair<std::shared_ptr<const Column>, Value>>& fixed_columns)
 {
     std::fill(fixed_targets_.begin(), fixed_targets_.end(), -1);
     std::fill(fixed_nights_.begin(), fixed_nights_.end(), -1);
+    approximate_pricing_failed_ = false;
     for (auto p: fixed_columns) {
         const Column& column = *(p.first);
         Value value = p.second;
@@ -147,82 +402,325 @@ std::vector<std::shared_ptr<const Column>> PricingSolver::initialize_pricing(
 struct ColumnExtra
 {
     NightId night_id;
-    starobservationschedulingsolver::single_night_star_observation_scheduling::Solution snsosp_solution;
-    std::vector<ObservableId> snsosp2sosp;
+    std::vector<Observation> observations;
 };
 
-PricingOutput PricingSolver::solve_pricing(
-            const std::vector<Value>& duals)
+starobservationschedulingsolver::single_night_star_observation_scheduling::Profit PricingSolver::target_profit(
+        TargetId target_id,
+        const std::vector<Value>& duals) const
 {
-    PricingOutput output;
-    Value reduced_cost_bound = 0.0;
+    if (fixed_targets_[target_id] == 1)
+        return 0;
+    return (starobservationschedulingsolver::single_night_star_observation_scheduling::Profit)instance_.target(target_id).profit
+        - duals[instance_.number_of_nights() + target_id];
+}
 
-    for (NightId night_id = 0;
-            night_id < instance_.number_of_nights();
-            ++night_id) {
-        if (fixed_nights_[night_id] == 1)
-            continue;
+void PricingSolver::solve_pricing_night(
+        NightId night_id,
+        const std::vector<Value>& duals,
+        bool approximate)
+{
+    night_columns_[night_id].clear();
+    night_reduced_cost_bounds_[night_id] = 0;
+    if (fixed_nights_[night_id] == 1)
+        return;
+
+    // Update subproblem profits.
+    // The targets of the observables are read from the structure of arrays
+    // of the night.
+    starobservationschedulingsolver::single_night_star_observation_scheduling::DynamicProgrammingSolver& snsosp_solver = snsosp_solvers_[night_id];
+    const NightObservables& night_observables = pricing_night_observables(night_id);
+    for (ObservablePos observable_pos = 0;
+            observable_pos < (ObservablePos)night_observables.observable_ids.size();
+            ++observable_pos) {
+        snsosp_solver.set_profit(
+                night_observables.observable_ids[observable_pos],
+                target_profit(night_observables.target_ids[observable_pos], duals));
+    }
 
-        // Build subproblem instance.
-        starobservationschedulingsolver::single_night_star_observation_scheduling::InstanceBuilder snsosp_instance_builder;
-        snsosp2sosp_.clear();
-        for (ObservableId observable_id = 0;
-                observable_id < (ObservableId)instance_.night(night_id).observables.size();
-                ++observable_id) {
-            const Observable& observable = instance_.observable(night_id, observable_id);
-            if (fixed_targets_[observable.target_id] == 1)
-                continue;
+    // Solve subproblem.
+    // A night whose best schedule has a non-positive reduced cost doesn't
+    // generate any column and doesn't change the reduced cost bound, so the
+    // dual value of the night is the threshold of the subproblem. The dynamic
+    // program stops as soon as it proves that no schedule reaches it.
+    // With the Pareto engine, only the stages after the first target whose
+    // profit has changed are recomputed.
+    // With value-only pricing, the schedule of the nights with a positive
+    // reduced cost is retrieved from checkpoints.
+    // The bound of an approximate subproblem is its profit divided by its
+    // guarantee, so the reduced cost bound stays valid.
+    snsosp_solver.set_threshold(duals[night_id]);
+    snsosp_solver.set_epsilon((approximate)? pricing_epsilon_: 0);
+    snsosp_solver.set_maximum_number_of_states((approximate)?
+            pricing_maximum_number_of_states_:
+            std::numeric_limits<Counter>::max());
+    Counter number_of_columns = number_of_columns_per_night_;
+    if (value_only_pricing_) {
+        snsosp_solver.set_storage(
+                starobservationschedulingsolver::single_night_star_observation_scheduling::DynamicProgrammingStorage::ValueOnly);
+        if (snsosp_solver.solve() <= duals[night_id] + FFOT_TOL) {
+            night_reduced_cost_bounds_[night_id] = snsosp_solver.bound() - duals[night_id];
+            return;
+        }
+        snsosp_solver.set_storage(
+                starobservationschedulingsolver::single_night_star_observation_scheduling::DynamicProgrammingStorage::Checkpoints);
+        number_of_columns = 1;
+    }
+    starobservationschedulingsolver::single_night_star_observation_scheduling::Profit profit = snsosp_solver.solve();
+    night_reduced_cost_bounds_[night_id] = snsosp_solver.bound() - duals[night_id];
+    if (profit <= duals[night_id] + FFOT_TOL)
+        return;
+    //std::cout << "night_id " << night_id
+    //    << " val " << snsosp_solver.profit()
+    //    << std::endl;
+
+    // Retrieve columns.
+    // The other schedules of the last stage are only returned if their
+    // reduced cost is positive.
+    std::vector<starobservationschedulingsolver::single_night_star_observation_scheduling::Observation> snsosp_observations;
+    for (Counter schedule_pos = 0;
+            schedule_pos < number_of_columns;
+            ++schedule_pos) {
+        if (schedule_pos > 0) {
+            if (schedule_pos >= snsosp_solver.number_of_schedules())
+                break;
+            if (snsosp_solver.schedule_profit(schedule_pos) <= duals[night_id] + FFOT_TOL)
+                break;
+        }
+        if (schedule_pos == 0) {
+            snsosp_observations = snsosp_solver.observations();
+        } else {
+            snsosp_solver.schedule_observations(schedule_pos, snsosp_observations);
+        }
+
+        add_column(night_id, snsosp_observations);
+    }
+}
+
+void PricingSolver::compute_segment_positive_profits(
+        const std::vector<Value>& duals)
+{
+    for (Counter segment_id = 0;
+            segment_id < (Counter)segment_solvers_.size();
+            ++segment_id) {
+        NightId night_id = segment_nights_[segment_id];
+        const NightObservables& night_observables = pricing_night_observables(night_id);
+        ObservablePos observable_start = segment_observable_starts_[segment_id];
+        segment_positive_profits_[segment_id] = 0;
+        for (starobservationschedulingsolver::single_night_star_observation_scheduling::TargetId target_id = 0;
+                target_id < segment_solvers_[segment_id].number_of_targets();
+                ++target_id) {
             starobservationschedulingsolver::single_night_star_observation_scheduling::Profit profit
-                = (starobservationschedulingsolver::single_night_star_observation_scheduling::Profit)instance_.target(observable.target_id).profit
-                - duals[instance_.number_of_nights() + observable.target_id];
-            if (profit <= 0)
-                continue;
-            snsosp_instance_builder.add_target(
-                    observable.release_date,
-                    observable.meridian,
-                    observable.deadline,
-                    observable.observation_time,
-                    profit);
-            snsosp2sosp_.push_back(observable_id);
+                = target_profit(night_observables.target_ids[observable_start + target_id], duals);
+            if (profit > 0)
+                segment_positive_profits_[segment_id] += profit;
         }
-        starobservationschedulingsolver::single_night_star_observation_scheduling::Instance snsosp_instance = snsosp_instance_builder.build();
-
-        // Solve subproblem instance.
-        starobservationschedulingsolver::single_night_star_observation_scheduling::DynamicProgrammingOptionalParameters snsosp_parameters;
-        snsosp_parameters.verbosity_level = 0;
-        auto snsosp_output = starobservationschedulingsolver::single_night_star_observation_scheduling::dynamic_programming(
-                snsosp_instance,
-                snsosp_parameters);
-        //std::cout << "night_id " << night_id
-        //    << " val " << snsosp_output.solution.profit()
-        //    << std::endl;
-
-        // Retrieve column.
-        Column column;
+    }
+}
+
+void PricingSolver::solve_pricing_segment(
+        Counter segment_id,
+        const std::vector<Value>& duals,
+        bool approximate)
+{
+    NightId night_id = segment_nights_[segment_id];
+    if (fixed_nights_[night_id] == 1)
+        return;
+
+    // Update subproblem profits.
+    starobservationschedulingsolver::single_night_star_observation_scheduling::DynamicProgrammingSolver& snsosp_solver = segment_solvers_[segment_id];
+    const NightObservables& night_observables = pricing_night_observables(night_id);
+    ObservablePos observable_start = segment_observable_starts_[segment_id];
+    for (starobservationschedulingsolver::single_night_star_observation_scheduling::TargetId target_id = 0;
+            target_id < snsosp_solver.number_of_targets();
+            ++target_id) {
+        snsosp_solver.set_profit(
+                target_id,
+                target_profit(night_observables.target_ids[observable_start + target_id], duals));
+    }
+
+    // Solve subproblem.
+    // The best schedule of the night is the concatenation of the best
+    // schedules of its segments. The positive profits of the other segments
+    // of the night bound their schedules, so the threshold of the segment is
+    // the dual value of the night minus these profits. If the segment stops
+    // early, the night has no schedule of positive reduced cost.
+    // The maximum number of states of the approximate pricing is shared
+    // between the segments of the night proportionally to their number of
+    // observables.
+    starobservationschedulingsolver::single_night_star_observation_scheduling::Profit other_segments_profit = 0;
+    for (Counter night_segment_id = night_segment_starts_[night_id];
+            night_segment_id < night_segment_starts_[night_id + 1];
+            ++night_segment_id) {
+        if (night_segment_id != segment_id)
+            other_segments_profit += segment_positive_profits_[night_segment_id];
+    }
+    snsosp_solver.set_threshold(duals[night_id] - other_segments_profit);
+    if (value_only_pricing_) {
+        snsosp_solver.set_storage(
+                starobservationschedulingsolver::single_night_star_observation_scheduling::DynamicProgrammingStorage::Checkpoints);
+    }
+    snsosp_solver.set_epsilon((approximate)? pricing_epsilon_: 0);
+    Counter maximum_number_of_states = std::numeric_limits<Counter>::max();
+    if (approximate
+            && pricing_maximum_number_of_states_ < std::numeric_limits<Counter>::max()) {
+        maximum_number_of_states = (std::max)((Counter)1, (Counter)(
+                    (double)pricing_maximum_number_of_states_
+                    * snsosp_solver.number_of_targets()
+                    / night_observables.observable_ids.size()));
+    }
+    snsosp_solver.set_maximum_number_of_states(maximum_number_of_states);
+    snsosp_solver.solve();
+}
+
+void PricingSolver::collect_pricing_segments(
+        NightId night_id,
+        const std::vector<Value>& duals)
+{
+    night_columns_[night_id].clear();
+    night_reduced_cost_bounds_[night_id] = 0;
+    if (fixed_nights_[night_id] == 1)
+        return;
+
+    // The observations of the segments are concatenated in the segment
+    // order, which is the time order.
+    // If a segment has stopped early, no schedule of the night has a positive
+    // reduced cost. Then, as with a single solver, the profit of the night
+    // is 0 and it doesn't generate any column. The sum of the bounds of the
+    // segments stays a valid bound.
+    const NightObservables& night_observables = pricing_night_observables(night_id);
+    starobservationschedulingsolver::single_night_star_observation_scheduling::Profit profit = 0;
+    starobservationschedulingsolver::single_night_star_observation_scheduling::Profit bound = 0;
+    bool stopped_early = false;
+    for (Counter segment_id = night_segment_starts_[night_id];
+            segment_id < night_segment_starts_[night_id + 1];
+            ++segment_id) {
+        profit += segment_solvers_[segment_id].profit();
+        bound += segment_solvers_[segment_id].bound();
+        if (segment_solvers_[segment_id].stopped_early())
+            stopped_early = true;
+    }
+    night_reduced_cost_bounds_[night_id] = bound - duals[night_id];
+    if (stopped_early)
+        return;
+    if (profit <= duals[night_id] + FFOT_TOL)
+        return;
+
+    std::vector<starobservationschedulingsolver::single_night_star_observation_scheduling::Observation> snsosp_observations;
+    for (Counter segment_id = night_segment_starts_[night_id];
+            segment_id < night_segment_starts_[night_id + 1];
+            ++segment_id) {
+        ObservablePos observable_start = segment_observable_starts_[segment_id];
+        for (auto snsosp_observation: segment_solvers_[segment_id].observations()) {
+            snsosp_observation.target_id = night_observables.observable_ids[observable_start + snsosp_observation.target_id];
+            snsosp_observations.push_back(snsosp_observation);
+        }
+    }
+    add_column(night_id, snsosp_observations);
+}
+
+void PricingSolver::add_column(
+        NightId night_id,
+        const std::vector<starobservationschedulingsolver::single_night_star_observation_scheduling::Observation>& snsosp_observations)
+{
+    Column column;
+    columngenerationsolver::LinearTerm element;
+    element.row = night_id;
+    element.coefficient = 1;
+    column.elements.push_back(element);
+    ColumnExtra extra;
+    extra.night_id = night_id;
+    for (const auto& snsosp_observation: snsosp_observations) {
+        ObservableId observable_id = snsosp_observation.target_id;
+        const Observable& observable = instance_.observable(night_id, observable_id);
         columngenerationsolver::LinearTerm element;
-        element.row = night_id;
+        element.row = instance_.number_of_nights() + observable.target_id;
         element.coefficient = 1;
         column.elements.push_back(element);
-        for (starobservationschedulingsolver::single_night_star_observation_scheduling::TargetId snsosp_observation_pos = 0;
-                snsosp_observation_pos < snsosp_output.solution.number_of_observations();
-                ++snsosp_observation_pos) {
-            const auto& snsosp_observation = snsosp_output.solution.observation(snsosp_observation_pos);
-            ObservableId observable_id = snsosp2sosp_[snsosp_observation.target_id];
-            const Observable& observable = instance_.observable(night_id, observable_id);
-            columngenerationsolver::LinearTerm element;
-            element.row = instance_.number_of_nights() + observable.target_id;
-            element.coefficient = 1;
-            column.elements.push_back(element);
-            column.objective_coefficient += instance_.target(observable.target_id).profit;
-        }
-        // Extra.
-        ColumnExtra extra {night_id, snsosp_output.solution, snsosp2sosp_};
-        column.extra = std::shared_ptr<void>(new ColumnExtra(extra));
-        output.columns.push_back(std::shared_ptr<const Column>(new Column(column)));
+        column.objective_coefficient += instance_.target(observable.target_id).profit;
+        Observation observation;
+        observation.observable_id = observable_id;
+        observation.start_time = snsosp_observation.start_time;
+        extra.observations.push_back(observation);
+    }
+    // Extra.
+    column.extra = std::shared_ptr<void>(new ColumnExtra(extra));
+    night_columns_[night_id].push_back(std::shared_ptr<const Column>(new Column(column)));
+}
+
+PricingOutput PricingSolver::solve_pricing(
+            const std::vector<Value>& duals)
+{
+    PricingOutput output;
+    Value reduced_cost_bound = 0.0;
 
+    // Price the nights.
+    // Each night, or each segment of a night with segmented pricing, has its
+    // own subproblem solver, so they can be priced concurrently.
+    // The thresholds of the segments depend on the profits of the other
+    // segments of their night, so these are computed first.
+    compute_segment_positive_profits(duals);
+
+    // With approximate pricing, the nights are priced again exactly if no
+    // column is found, so that the column generation only stops when no
+    // column has a positive reduced cost. After that, the pricing stays
+    // exact until the next column generation, see
+    // 'approximate_pricing_failed_'.
+    bool approximate = !approximate_pricing_failed_
+        && (pricing_epsilon_ > 0
+            || pricing_maximum_number_of_states_ < std::numeric_limits<Counter>::max());
+    auto price_nights = [this, &duals](bool approximate)
+    {
+        thread_pool_.run(
+                pricing_tasks_.size(),
+                [this, &duals, approximate](int64_t task_id)
+                {
+                    NightId night_id = pricing_tasks_[task_id].first;
+                    Counter segment_id = pricing_tasks_[task_id].second;
+                    if (segment_id == -1) {
+                        solve_pricing_night(night_id, duals, approximate);
+                    } else {
+                        solve_pricing_segment(segment_id, duals, approximate);
+                    }
+                });
+        for (NightId night_id = 0;
+                night_id < instance_.number_of_nights();
+                ++night_id) {
+            if (night_segment_starts_[night_id + 1] > night_segment_starts_[night_id])
+                collect_pricing_segments(night_id, duals);
+        }
+    };
+    price_nights(approximate);
+    if (approximate
+            && std::all_of(
+                night_columns_.begin(),
+                night_columns_.end(),
+                [](const std::vector<std::shared_ptr<const Column>>& columns)
+                {
+                    return columns.empty();
+                })) {
+        approximate_pricing_failed_ = true;
+        price_nights(false);
+    }
+    for (NightId night_id = 0;
+            night_id < instance_.number_of_nights();
+            ++night_id) {
         reduced_cost_bound = (std::max)(
                 reduced_cost_bound,
-                columngenerationsolver::compute_reduced_cost(column, duals));
+                night_reduced_cost_bounds_[night_id]);
+    }
+
+    // Collect the columns in the night order, so that the output doesn't
+    // depend on the number of threads.
+    for (NightId night_id = 0;
+            night_id < instance_.number_of_nights();
+            ++night_id) {
+        for (const auto& column: night_columns_[night_id]) {
+            output.columns.push_back(column);
+            reduced_cost_bound = (std::max)(
+                    reduced_cost_bound,
+                    columngenerationsolver::compute_reduced_cost(*column, duals));
+        }
     }
 
     output.overcost = instance_.number_of_nights() * std::max(0.0, reduced_cost_bound);
@@ -237,13 +735,8 @@ Solution columns2solution(
     for (const auto& colval: cg_solution.columns()) {
         std::shared_ptr<ColumnExtra> extra
             = std::static_pointer_cast<ColumnExtra>(colval.first->extra);
-        for (starobservationschedulingsolver::single_night_star_observation_scheduling::TargetId snsosp_observation_pos = 0;
-                snsosp_observation_pos < extra->snsosp_solution.number_of_observations();
-                ++snsosp_observation_pos) {
-            const auto& snsosp_observation = extra->snsosp_solution.observation(snsosp_observation_pos);
-            ObservableId observable_id = extra->snsosp2sosp[snsosp_observation.target_id];
-            sol[extra->night_id].push_back({observable_id, snsosp_observation.start_time});
-        }
+        for (const Observation& observation: extra->observations)
+            sol[extra->night_id].push_back({observation.observable_id, observation.start_time});
     }
 
     Solution solution(instance);
@@ -264,6 +757,100 @@ Solution columns2solution(
     return solution;
 }
 
+/**
+ * Solve the connected components of an instance independently with the
+ * greedy column generation heuristic and merge their solutions and bounds.
+ */
+void column_generation_greedy_components(
+        const Instance& instance,
+        const ColumnGenerationOptionalParameters& parameters,
+        AlgorithmFormatter& algorithm_formatter)
+{
+    Counter number_of_components = instance.number_of_components();
+    std::vector<Instance> component_instances;
+    component_instances.reserve(number_of_components);
+    for (Counter component_id = 0;
+            component_id < number_of_components;
+            ++component_id) {
+        component_instances.push_back(instance.component_instance(component_id));
+    }
+
+    // Best solution and bound of each component.
+    std::vector<Solution> component_solutions;
+    std::vector<Profit> component_bounds;
+    for (const Instance& component_instance: component_instances) {
+        component_solutions.push_back(Solution(component_instance));
+        component_bounds.push_back(component_instance.total_profit());
+    }
+
+    // Merge the solutions and the bounds of the components. The nights of a
+    // component keep the order of their observations.
+    std::mutex mutex;
+    auto update = [&instance, &algorithm_formatter, &component_solutions, &component_bounds]()
+    {
+        Solution solution(instance);
+        Profit bound = instance.fixed_profit();
+        for (Counter component_id = 0;
+                component_id < instance.number_of_components();
+                ++component_id) {
+            const Solution& component_solution = component_solutions[component_id];
+            starobservationschedulingsolver::Span<NightId> night_ids = instance.component_nights(component_id);
+            for (NightId night_pos = 0;
+                    night_pos < (NightId)night_ids.size();
+                    ++night_pos) {
+                for (const Observation& observation: component_solution.night(night_pos).observations) {
+                    solution.append_observation(
+                            night_ids[night_pos],
+                            observation.observable_id,
+                            observation.start_time);
+                }
+            }
+            bound += component_bounds[component_id];
+        }
+        algorithm_formatter.update_solution(solution, "");
+        algorithm_formatter.update_bound(bound, "");
+    };
+
+    // The components are solved concurrently. The threads are shared between
+    // the components solved at the same time, which price their nights with
+    // the remaining threads.
+    Counter number_of_concurrent_components = (std::min)(
+            (std::max)((Counter)1, parameters.number_of_threads),
+            number_of_components);
+    starobservationschedulingsolver::ThreadPool thread_pool(number_of_concurrent_components);
+    thread_pool.run(
+            number_of_components,
+            [&parameters, number_of_concurrent_components,
+            &component_instances, &component_solutions, &component_bounds,
+            &mutex, &update](int64_t component_id)
+            {
+                ColumnGenerationOptionalParameters component_parameters = parameters;
+                component_parameters.verbosity_level = 0;
+                component_parameters.messages_to_stdout = false;
+                component_parameters.log_path = "";
+                component_parameters.number_of_threads = (std::max)(
+                        (Counter)1,
+                        parameters.number_of_threads / number_of_concurrent_components);
+                component_parameters.new_solution_callback = [
+                    component_id,
+                    &component_solutions,
+                    &component_bounds,
+                    &mutex,
+                    &update](
+                            const Output& component_output,
+                            const std::string&)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    component_solutions[component_id] = component_output.solution;
+                    component_bounds[component_id] = component_output.bound;
+                    update();
+                };
+                column_generation_greedy(
+                        component_instances[component_id],
+                        component_parameters);
+            });
+}
+
 }
 
 const ColumnGenerationGreedyOutput starobservationschedulingsolver::star_observation_scheduling::column_generation_greedy(
@@ -275,7 +862,17 @@ const ColumnGenerationGreedyOutput starobservationschedulingsolver::star_observa
     algorithm_formatter.start("Column generation heuristic - greedy");
     algorithm_formatter.print_header();
 
-    columngenerationsolver::Model model = get_model(instance);
+    // Solve the connected components independently.
+    if (parameters.decomposition && instance.number_of_components() > 1) {
+        column_generation_greedy_components(
+                instance,
+                parameters,
+                algorithm_formatter);
+        algorithm_formatter.end();
+        return output;
+    }
+
+    columngenerationsolver::Model model = get_model(instance, parameters);
     columngenerationsolver::GreedyParameters greedy_parameters;
     greedy_parameters.timer = parameters.timer;
     greedy_parameters.verbosity_level = 0;
@@ -291,7 +888,7 @@ const ColumnGenerationGreedyOutput starobservationschedulingsolver::star_observa
     greedy_parameters.new_bound_callback = [&instance, &algorithm_formatter](
             const columngenerationsolver::Output& cgs_output)
     {
-        Profit bound = std::ceil(cgs_output.bound - FFOT_TOL);
+        Profit bound = std::ceil(cgs_output.bound - FFOT_TOL) + instance.fixed_profit();
         algorithm_formatter.update_bound(bound, "");
     };
     greedy_parameters.column_generation_parameters.solver_name
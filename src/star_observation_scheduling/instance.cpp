@@ -1,10 +1,14 @@
 #include "starobservationschedulingsolver/star_observation_scheduling/instance.hpp"
 
+#include "starobservationschedulingsolver/star_observation_scheduling/instance_builder.hpp"
+
 #include "optimizationtools/containers/indexed_set.hpp"
 
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <numeric>
+#include <algorithm>
 
 using namespace starobservationschedulingsolver::star_observation_scheduling;
 
@@ -14,10 +18,21 @@ std::ostream& Instance::format(
 {
     if (verbosity_level >= 1) {
         os
-            << "Number of nights:       " << number_of_nights() << std::endl
-            << "Number of targets:      " << number_of_targets() << std::endl
-            << "Number of observables:  " << number_of_observables() << std::endl
+            << "Number of nights:                        " << number_of_nights() << std::endl
+            << "Number of targets:                       " << number_of_targets() << std::endl
+            << "Number of observables:                   " << number_of_observables() << std::endl
+            << "Number of components:                    " << number_of_components() << std::endl
             ;
+        if (reduced()) {
+            os
+                << "Number of infeasible observables:        " << number_of_infeasible_observables() << std::endl
+                << "Number of unprofitable targets:          " << number_of_unprofitable_targets() << std::endl
+                << "Number of dominated observables:         " << number_of_dominated_observables() << std::endl
+                << "Number of observables of fixed targets:  " << number_of_observables_of_fixed_targets() << std::endl
+                << "Number of fixed targets:                 " << number_of_fixed_targets() << std::endl
+                << "Fixed profit:                            " << fixed_profit() << std::endl
+                ;
+        }
     }
 
     if (verbosity_level >= 2) {
@@ -37,7 +52,7 @@ std::ostream& Instance::format(
             os
                 << std::setw(12) << target_id
                 << std::setw(12) << target.profit
-                << std::setw(12) << target.observables.size()
+                << std::setw(12) << target.number_of_observables
                 << std::endl;
         }
     }
@@ -84,6 +99,67 @@ std::ostream& Instance::format(
     return os;
 }
 
+NightObservables Instance::compute_night_observables(
+        NightId night_id) const
+{
+    const Night& night = this->night(night_id);
+    NightObservables night_observables;
+    night_observables.observable_ids = std::vector<ObservableId>(night.observables.size());
+    std::iota(
+            night_observables.observable_ids.begin(),
+            night_observables.observable_ids.end(),
+            0);
+    std::stable_sort(
+            night_observables.observable_ids.begin(),
+            night_observables.observable_ids.end(),
+            [&night](ObservableId observable_id_1, ObservableId observable_id_2)
+            {
+                return night.observables[observable_id_1].meridian
+                    < night.observables[observable_id_2].meridian;
+            });
+    for (ObservableId observable_id: night_observables.observable_ids) {
+        const Observable& observable = night.observables[observable_id];
+        night_observables.target_ids.push_back(observable.target_id);
+        night_observables.release_dates.push_back(observable.release_date);
+        night_observables.meridians.push_back(observable.meridian);
+        night_observables.deadlines.push_back(observable.deadline);
+        night_observables.observation_times.push_back(observable.observation_time);
+    }
+    return night_observables;
+}
+
+Instance Instance::component_instance(
+        Counter component_id) const
+{
+    Span<NightId> night_ids = component_nights(component_id);
+    Span<TargetId> target_ids = component_targets(component_id);
+
+    InstanceBuilder instance_builder;
+    instance_builder.set_number_of_nights(night_ids.size());
+    instance_builder.set_number_of_targets(target_ids.size());
+    for (TargetId target_pos = 0;
+            target_pos < (TargetId)target_ids.size();
+            ++target_pos) {
+        instance_builder.set_profit(
+                target_pos,
+                target(target_ids[target_pos]).profit);
+    }
+    for (NightId night_pos = 0;
+            night_pos < (NightId)night_ids.size();
+            ++night_pos) {
+        for (const Observable& observable: night(night_ids[night_pos]).observables) {
+            instance_builder.add_observable(
+                    night_pos,
+                    target_component_positions_[observable.target_id],
+                    observable.release_date,
+                    observable.meridian,
+                    observable.deadline,
+                    observable.observation_time);
+        }
+    }
+    return instance_builder.build();
+}
+
 std::pair<bool, Profit> Instance::check(
         const std::string& certificate_path,
         std::ostream& os,
@@ -95,6 +171,12 @@ std::pair<bool, Profit> Instance::check(
                 "starobservationschedulingsolver::Instance::check\n"
                 "Unable to open file \"" + certificate_path + "\".");
     }
+    if (reduced()) {
+        throw std::invalid_argument(
+                "starobservationschedulingsolver::Instance::check\n"
+                "Certificates use the original ids; "
+                "check them with the instance built without reduction.");
+    }
 
     if (verbosity_level >= 2) {
         os << std::endl
@@ -2,6 +2,9 @@
 
 #include <fstream>
 #include <sstream>
+#include <numeric>
+#include <algorithm>
+#include <limits>
 
 using namespace starobservationschedulingsolver::star_observation_scheduling;
 
@@ -25,8 +28,6 @@ void InstanceBuilder::add_observable(
         Time deadline,
         Time observation_time)
 {
-    ObservableId observable_id = instance_.nights_[night_id].observables.size();
-
     Observable observable;
     observable.target_id = target_id;
     observable.release_date = release_date;
@@ -39,7 +40,6 @@ void InstanceBuilder::add_observable(
         instance_.nights_[night_id].start = release_date;
     if (instance_.nights_[night_id].end < deadline)
         instance_.nights_[night_id].end = deadline;
-    instance_.targets_[target_id].observables.push_back({night_id, observable_id});
 }
 
 void InstanceBuilder::set_profit(
@@ -49,6 +49,12 @@ void InstanceBuilder::set_profit(
     instance_.targets_[target_id].profit = profit;
 }
 
+void InstanceBuilder::set_unicost()
+{
+    for (Target& target: instance_.targets_)
+        target.profit = 1;
+}
+
 void InstanceBuilder::read(
         const std::string& instance_path,
         const std::string& format)
@@ -123,8 +129,274 @@ void InstanceBuilder::read_catusse2016(
     }
 }
 
+void InstanceBuilder::reduce()
+{
+    NightId number_of_nights = instance_.number_of_nights();
+    TargetId number_of_targets = instance_.number_of_targets();
+    auto earliest_start = [](const Observable& observable)
+    {
+        return (std::max)((Time)0, observable.release_date);
+    };
+
+    // Remaining observables of each night, as original observable ids.
+    std::vector<std::vector<ObservableId>> remaining_observables(number_of_nights);
+    std::vector<Counter> target_number_of_remaining_observables(number_of_targets, 0);
+    std::vector<NightId> fixed_nights(number_of_targets, -1);
+    std::vector<ObservableId> fixed_observables(number_of_targets, -1);
+    for (NightId night_id = 0;
+            night_id < number_of_nights;
+            ++night_id) {
+        const Night& night = instance_.nights_[night_id];
+        for (ObservableId observable_id = 0;
+                observable_id < (ObservableId)night.observables.size();
+                ++observable_id) {
+            const Observable& observable = night.observables[observable_id];
+            if (observable.deadline - earliest_start(observable)
+                    < observable.observation_time) {
+                instance_.number_of_infeasible_observables_++;
+                continue;
+            }
+            if (instance_.targets_[observable.target_id].profit <= 0)
+                continue;
+            remaining_observables[night_id].push_back(observable_id);
+            target_number_of_remaining_observables[observable.target_id]++;
+        }
+    }
+    for (TargetId target_id = 0;
+            target_id < number_of_targets;
+            ++target_id) {
+        if (instance_.targets_[target_id].profit <= 0)
+            instance_.number_of_unprofitable_targets_++;
+    }
+
+    // Remove the observables dominated by another observable of the same
+    // target during the same night. If the time window of an observable
+    // contains the time window of another one and its observation time is
+    // not longer, any observation of the second one can be replaced by an
+    // observation of the first one starting at the same time. Among
+    // identical observables, the one with the smallest id is kept.
+    std::vector<ObservableId> sorted_observables;
+    for (NightId night_id = 0;
+            night_id < number_of_nights;
+            ++night_id) {
+        const Night& night = instance_.nights_[night_id];
+        std::vector<ObservableId>& observables = remaining_observables[night_id];
+        sorted_observables = observables;
+        std::sort(
+                sorted_observables.begin(),
+                sorted_observables.end(),
+                [&night](
+                    ObservableId observable_id_1,
+                    ObservableId observable_id_2)
+                {
+                    TargetId target_id_1 = night.observables[observable_id_1].target_id;
+                    TargetId target_id_2 = night.observables[observable_id_2].target_id;
+                    if (target_id_1 != target_id_2)
+                        return target_id_1 < target_id_2;
+                    return observable_id_1 < observable_id_2;
+                });
+
+        std::vector<bool> dominated(night.observables.size(), false);
+        ObservableId group_start = 0;
+        while (group_start < (ObservableId)sorted_observables.size()) {
+            TargetId target_id = night.observables[sorted_observables[group_start]].target_id;
+            ObservableId group_end = group_start + 1;
+            while (group_end < (ObservableId)sorted_observables.size()
+                    && night.observables[sorted_observables[group_end]].target_id == target_id) {
+                group_end++;
+            }
+            for (ObservableId pos = group_start; pos < group_end; ++pos) {
+                const Observable& observable = night.observables[sorted_observables[pos]];
+                for (ObservableId pos_2 = group_start; pos_2 < group_end; ++pos_2) {
+                    if (pos_2 == pos)
+                        continue;
+                    const Observable& observable_2 = night.observables[sorted_observables[pos_2]];
+                    if (earliest_start(observable_2) > earliest_start(observable)
+                            || observable_2.deadline < observable.deadline
+                            || observable_2.observation_time > observable.observation_time) {
+                        continue;
+                    }
+                    // Identical observables: keep the first one.
+                    if (earliest_start(observable_2) == earliest_start(observable)
+                            && observable_2.deadline == observable.deadline
+                            && observable_2.observation_time == observable.observation_time
+                            && pos_2 > pos) {
+                        continue;
+                    }
+                    dominated[sorted_observables[pos]] = true;
+                    break;
+                }
+            }
+            group_start = group_end;
+        }
+
+        observables.erase(
+                std::remove_if(
+                    observables.begin(),
+                    observables.end(),
+                    [&dominated](ObservableId observable_id)
+                    {
+                        return dominated[observable_id];
+                    }),
+                observables.end());
+        for (ObservableId observable_id = 0;
+                observable_id < (ObservableId)night.observables.size();
+                ++observable_id) {
+            if (!dominated[observable_id])
+                continue;
+            instance_.number_of_dominated_observables_++;
+            target_number_of_remaining_observables[night.observables[observable_id].target_id]--;
+        }
+    }
+
+    // Fix the targets having an observable whose time window doesn't
+    // intersect the time window of the other remaining observables of its
+    // night. Observing the target with this observable doesn't prevent any
+    // other observation, so there is an optimal solution that does it.
+    // Removing the observables of a fixed target may free other observables,
+    // hence the loop.
+    for (;;) {
+        bool changed = false;
+        for (NightId night_id = 0;
+                night_id < number_of_nights;
+                ++night_id) {
+            const Night& night = instance_.nights_[night_id];
+
+            // Remove the observables of the fixed targets.
+            std::vector<ObservableId>& observables = remaining_observables[night_id];
+            observables.erase(
+                    std::remove_if(
+                        observables.begin(),
+                        observables.end(),
+                        [&night, &fixed_nights](ObservableId observable_id)
+                        {
+                            return fixed_nights[night.observables[observable_id].target_id] != -1;
+                        }),
+                    observables.end());
+
+            sorted_observables = observables;
+            std::sort(
+                    sorted_observables.begin(),
+                    sorted_observables.end(),
+                    [&night, &earliest_start](
+                        ObservableId observable_id_1,
+                        ObservableId observable_id_2)
+                    {
+                        const Observable& observable_1 = night.observables[observable_id_1];
+                        const Observable& observable_2 = night.observables[observable_id_2];
+                        Time start_1 = earliest_start(observable_1);
+                        Time start_2 = earliest_start(observable_2);
+                        if (start_1 != start_2)
+                            return start_1 < start_2;
+                        if (observable_1.deadline != observable_2.deadline)
+                            return observable_1.deadline < observable_2.deadline;
+                        return observable_id_1 < observable_id_2;
+                    });
+
+            // An observable is free if the deadlines of the previous
+            // observables are not after its earliest start and if the
+            // earliest start of the next one is not before its deadline.
+            Time latest_deadline = std::numeric_limits<Time>::min();
+            for (ObservableId pos = 0;
+                    pos < (ObservableId)sorted_observables.size();
+                    ++pos) {
+                const Observable& observable = night.observables[sorted_observables[pos]];
+                Time next_start = (pos + 1 < (ObservableId)sorted_observables.size())?
+                    earliest_start(night.observables[sorted_observables[pos + 1]]):
+                    std::numeric_limits<Time>::max();
+                if (fixed_nights[observable.target_id] == -1
+                        && latest_deadline <= earliest_start(observable)
+                        && next_start >= observable.deadline) {
+                    fixed_nights[observable.target_id] = night_id;
+                    fixed_observables[observable.target_id] = sorted_observables[pos];
+                    changed = true;
+                }
+                latest_deadline = (std::max)(latest_deadline, observable.deadline);
+            }
+        }
+        if (!changed)
+            break;
+    }
+
+    // Build the reduced targets.
+    std::vector<Target> targets;
+    std::vector<TargetId> new_target_ids(number_of_targets, -1);
+    for (TargetId target_id = 0;
+            target_id < number_of_targets;
+            ++target_id) {
+        const Target& target = instance_.targets_[target_id];
+        if (fixed_nights[target_id] != -1) {
+            instance_.fixed_profit_ += target.profit;
+            instance_.number_of_fixed_targets_++;
+            instance_.number_of_observables_of_fixed_targets_
+                += target_number_of_remaining_observables[target_id] - 1;
+            continue;
+        }
+        if (target_number_of_remaining_observables[target_id] == 0)
+            continue;
+        new_target_ids[target_id] = targets.size();
+        instance_.original_target_ids_.push_back(target_id);
+        Target new_target;
+        new_target.profit = target.profit;
+        targets.push_back(new_target);
+    }
+
+    // Build the reduced nights.
+    std::vector<Night> nights(number_of_nights);
+    for (NightId night_id = 0;
+            night_id < number_of_nights;
+            ++night_id) {
+        const Night& night = instance_.nights_[night_id];
+        Night& new_night = nights[night_id];
+        for (ObservableId observable_id: remaining_observables[night_id]) {
+            Observable observable = night.observables[observable_id];
+            observable.target_id = new_target_ids[observable.target_id];
+            new_night.observables.push_back(observable);
+            new_night.original_observable_ids.push_back(observable_id);
+            if (new_night.start > observable.release_date)
+                new_night.start = observable.release_date;
+            if (new_night.end < observable.deadline)
+                new_night.end = observable.deadline;
+        }
+    }
+    for (TargetId target_id = 0;
+            target_id < number_of_targets;
+            ++target_id) {
+        NightId night_id = fixed_nights[target_id];
+        if (night_id == -1)
+            continue;
+        ObservableId observable_id = fixed_observables[target_id];
+        const Observable& observable = instance_.nights_[night_id].observables[observable_id];
+        FixedObservation fixed_observation;
+        fixed_observation.original_observable_id = observable_id;
+        fixed_observation.original_target_id = target_id;
+        fixed_observation.start_time = earliest_start(observable);
+        fixed_observation.end_time = fixed_observation.start_time + observable.observation_time;
+        nights[night_id].fixed_observations.push_back(fixed_observation);
+    }
+    for (Night& night: nights) {
+        std::sort(
+                night.fixed_observations.begin(),
+                night.fixed_observations.end(),
+                [](
+                    const FixedObservation& fixed_observation_1,
+                    const FixedObservation& fixed_observation_2)
+                {
+                    return fixed_observation_1.start_time
+                        < fixed_observation_2.start_time;
+                });
+    }
+
+    instance_.nights_ = std::move(nights);
+    instance_.targets_ = std::move(targets);
+    instance_.reduced_ = true;
+}
+
 Instance InstanceBuilder::build()
 {
+    if (reduction_)
+        reduce();
+
     // Compute number_of_observables_.
     for (NightId night_id = 0;
             night_id < instance_.number_of_nights();
@@ -132,7 +404,144 @@ Instance InstanceBuilder::build()
         instance_.number_of_observables_ += instance_.nights_[night_id].observables.size();
     }
 
+    // Compute target_observables_.
+    // The observables of each target are grouped with a counting sort, so
+    // that the observables of a target are sorted by night.
+    for (NightId night_id = 0;
+            night_id < instance_.number_of_nights();
+            ++night_id) {
+        for (const Observable& observable: instance_.nights_[night_id].observables)
+            instance_.targets_[observable.target_id].number_of_observables++;
+    }
+    Counter observables_start = 0;
+    for (TargetId target_id = 0;
+            target_id < instance_.number_of_targets();
+            ++target_id) {
+        Target& target = instance_.targets_[target_id];
+        target.observables_start = observables_start;
+        observables_start += target.number_of_observables;
+        target.number_of_observables = 0;
+    }
+    instance_.target_observables_ = std::vector<std::pair<NightId, ObservableId>>(observables_start);
+    for (NightId night_id = 0;
+            night_id < instance_.number_of_nights();
+            ++night_id) {
+        const Night& night = instance_.nights_[night_id];
+        for (ObservableId observable_id = 0;
+                observable_id < (ObservableId)night.observables.size();
+                ++observable_id) {
+            Target& target = instance_.targets_[night.observables[observable_id].target_id];
+            instance_.target_observables_[target.observables_start + target.number_of_observables]
+                = {night_id, observable_id};
+            target.number_of_observables++;
+        }
+    }
+
+    // Compute night_observables_.
+    if (night_observables_) {
+        instance_.night_observables_.reserve(instance_.number_of_nights());
+        for (NightId night_id = 0;
+                night_id < instance_.number_of_nights();
+                ++night_id) {
+            instance_.night_observables_.push_back(
+                    instance_.compute_night_observables(night_id));
+        }
+    }
+
+    // Compute the connected components of the bipartite night-target
+    // graph with a union-find. Vertex 'night_id' is a night and vertex
+    // 'number_of_nights + target_id' a target.
+    NightId number_of_nights = instance_.number_of_nights();
+    std::vector<Counter> parents(number_of_nights + instance_.number_of_targets());
+    std::iota(parents.begin(), parents.end(), 0);
+    auto find = [&parents](Counter vertex)
+    {
+        while (parents[vertex] != vertex) {
+            parents[vertex] = parents[parents[vertex]];
+            vertex = parents[vertex];
+        }
+        return vertex;
+    };
+    for (NightId night_id = 0;
+            night_id < number_of_nights;
+            ++night_id) {
+        for (const Observable& observable: instance_.nights_[night_id].observables) {
+            Counter root_1 = find(night_id);
+            Counter root_2 = find(number_of_nights + observable.target_id);
+            // Keep the smallest vertex as root, so that the root of a
+            // component is its first night.
+            if (root_1 < root_2) {
+                parents[root_2] = root_1;
+            } else if (root_2 < root_1) {
+                parents[root_1] = root_2;
+            }
+        }
+    }
+    std::vector<Counter> root_components(parents.size(), -1);
+    instance_.night_components_ = std::vector<Counter>(number_of_nights, -1);
+    instance_.target_components_ = std::vector<Counter>(instance_.number_of_targets(), -1);
+    for (NightId night_id = 0;
+            night_id < number_of_nights;
+            ++night_id) {
+        if (instance_.nights_[night_id].observables.empty())
+            continue;
+        Counter root = find(night_id);
+        if (root_components[root] == -1) {
+            root_components[root] = instance_.components_.size();
+            instance_.components_.push_back(Component());
+        }
+        Counter component_id = root_components[root];
+        instance_.night_components_[night_id] = component_id;
+        instance_.components_[component_id].number_of_nights++;
+        instance_.components_[component_id].number_of_observables
+            += instance_.nights_[night_id].observables.size();
+    }
+    for (TargetId target_id = 0;
+            target_id < instance_.number_of_targets();
+            ++target_id) {
+        if (instance_.targets_[target_id].number_of_observables == 0)
+            continue;
+        Counter component_id = root_components[find(number_of_nights + target_id)];
+        instance_.target_components_[target_id] = component_id;
+        instance_.components_[component_id].number_of_targets++;
+    }
+    Counter nights_start = 0;
+    Counter targets_start = 0;
+    for (Component& component: instance_.components_) {
+        component.nights_start = nights_start;
+        component.targets_start = targets_start;
+        nights_start += component.number_of_nights;
+        targets_start += component.number_of_targets;
+        component.number_of_nights = 0;
+        component.number_of_targets = 0;
+    }
+    instance_.component_nights_ = std::vector<NightId>(nights_start);
+    instance_.component_targets_ = std::vector<TargetId>(targets_start);
+    instance_.target_component_positions_ = std::vector<TargetId>(instance_.number_of_targets(), -1);
+    for (NightId night_id = 0;
+            night_id < number_of_nights;
+            ++night_id) {
+        Counter component_id = instance_.night_components_[night_id];
+        if (component_id == -1)
+            continue;
+        Component& component = instance_.components_[component_id];
+        instance_.component_nights_[component.nights_start + component.number_of_nights] = night_id;
+        component.number_of_nights++;
+    }
+    for (TargetId target_id = 0;
+            target_id < instance_.number_of_targets();
+            ++target_id) {
+        Counter component_id = instance_.target_components_[target_id];
+        if (component_id == -1)
+            continue;
+        Component& component = instance_.components_[component_id];
+        instance_.component_targets_[component.targets_start + component.number_of_targets] = target_id;
+        instance_.target_component_positions_[target_id] = component.number_of_targets;
+        component.number_of_targets++;
+    }
+
     // Compute profit_sum_.
+    instance_.profit_sum_ = instance_.fixed_profit_;
     for (TargetId target_id = 0;
             target_id < instance_.number_of_targets();
             ++target_id) {
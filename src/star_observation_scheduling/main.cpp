@@ -50,6 +50,17 @@ Output run(
     if (algorithm == "column-generation") {
         ColumnGenerationOptionalParameters parameters;
         read_args(parameters, vm);
+        if (vm.count("number-of-threads"))
+            parameters.number_of_threads = vm["number-of-threads"].as<Counter>();
+        if (vm.count("number-of-columns-per-night"))
+            parameters.number_of_columns_per_night = vm["number-of-columns-per-night"].as<Counter>();
+        parameters.value_only_pricing = vm.count("value-only-pricing");
+        if (vm.count("pricing-epsilon"))
+            parameters.pricing_epsilon = vm["pricing-epsilon"].as<double>();
+        if (vm.count("pricing-maximum-number-of-states"))
+            parameters.pricing_maximum_number_of_states = vm["pricing-maximum-number-of-states"].as<Counter>();
+        parameters.segmented_pricing = vm.count("segmented-pricing");
+        parameters.decomposition = !vm.count("no-decomposition");
         return column_generation_greedy(instance, parameters);
 #ifdef XPRESS_FOUND
     } else if (algorithm == "benders-decomposition") {
@@ -74,6 +85,7 @@ int main(int argc, char *argv[])
         ("input,i", po::value<std::string>()->required(), "set input file (required)")
         ("format,f", po::value<std::string>()->default_value(""), "set input file format (default: standard)")
         ("unicost,u", "set unicost")
+        ("reduction,", "reduce the instance before solving it")
         ("output,o", po::value<std::string>()->default_value(""), "set JSON output file")
         ("initial-solution,", po::value<std::string>()->default_value(""), "")
         ("certificate,c", po::value<std::string>()->default_value(""), "set certificate file")
@@ -86,6 +98,13 @@ int main(int argc, char *argv[])
 
         ("maximum-number-of-iterations,", po::value<int>(), "set the maximum number of iterations")
         ("maximum-number-of-iterations-without-improvement,", po::value<int>(), "set the maximum number of iterations without improvement")
+        ("number-of-threads,", po::value<Counter>(), "set the number of threads")
+        ("number-of-columns-per-night,", po::value<Counter>(), "set the maximum number of columns generated per night")
+        ("value-only-pricing,", "solve the pricing subproblems value-only and retrieve the columns from checkpoints")
+        ("pricing-epsilon,", po::value<double>(), "set the relative accuracy of the approximate pricing")
+        ("pricing-maximum-number-of-states,", po::value<Counter>(), "set the maximum number of states of a pricing subproblem during the approximate pricing")
+        ("segmented-pricing,", "split the pricing subproblem of each night into independent segments")
+        ("no-decomposition,", "solve the connected components of the instance together")
         ;
     po::variables_map vm;
     po::store(po::parse_command_line(argc, argv, desc), vm);
@@ -105,6 +124,10 @@ int main(int argc, char *argv[])
     instance_builder.read(
             vm["input"].as<std::string>(),
             vm["format"].as<std::string>());
+    if (vm.count("unicost"))
+        instance_builder.set_unicost();
+    if (vm.count("reduction"))
+        instance_builder.set_reduction(true);
     const Instance instance = instance_builder.build();
 
     // Run.
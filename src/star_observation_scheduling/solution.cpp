@@ -2,13 +2,17 @@
 
 #include "optimizationtools/utils/utils.hpp"
 
+#include <algorithm>
+
 using namespace starobservationschedulingsolver::star_observation_scheduling;
 
 Solution::Solution(
         const Instance& instance):
     instance_(&instance),
     targets_(instance.number_of_targets(), 0),
-    nights_(instance.number_of_nights())
+    nights_(instance.number_of_nights()),
+    number_of_observations_(instance.number_of_fixed_targets()),
+    profit_(instance.fixed_profit())
 {  }
 
 void Solution::append_observation(
@@ -52,7 +56,7 @@ std::ostream& Solution::format(
 {
     if (verbosity_level >= 1) {
         os
-            << "Number of targets:  " << optimizationtools::Ratio<TargetId>(number_of_observations(), instance().number_of_targets()) << std::endl
+            << "Number of targets:  " << optimizationtools::Ratio<TargetId>(number_of_observations(), instance().number_of_targets() + instance().number_of_fixed_targets()) << std::endl
             << "Feasible:           " << feasible() << std::endl
             << "Profit:             " << optimizationtools::Ratio<Profit>(profit(), instance().total_profit()) << std::endl
             ;
@@ -118,12 +122,49 @@ void Solution::write(
             night_id < instance().number_of_nights();
             ++night_id) {
         const SolutionNight& night = this->night(night_id);
-        file << night.observations.size() << std::endl;
-        for (const auto& observation: night.observations)
-            file << observation.observable_id
-                << " " << instance().observable(night_id, observation.observable_id).target_id
+        if (!instance().reduced()) {
+            file << night.observations.size() << std::endl;
+            for (const auto& observation: night.observations)
+                file << observation.observable_id
+                    << " " << instance().observable(night_id, observation.observable_id).target_id
+                    << " " << observation.start_time
+                    << " " << observation.start_time + instance().observable(night_id, observation.observable_id).observation_time
+                    << std::endl;;
+            continue;
+        }
+
+        // Merge the fixed observations of the night with the observations
+        // of the solution, both sorted by start time, with the original ids.
+        const std::vector<FixedObservation>& fixed_observations
+            = instance().night(night_id).fixed_observations;
+        std::vector<FixedObservation> observations;
+        for (const auto& observation: night.observations) {
+            const Observable& observable = instance().observable(night_id, observation.observable_id);
+            FixedObservation original_observation;
+            original_observation.original_observable_id = instance().original_observable_id(night_id, observation.observable_id);
+            original_observation.original_target_id = instance().original_target_id(observable.target_id);
+            original_observation.start_time = observation.start_time;
+            original_observation.end_time = observation.start_time + observable.observation_time;
+            observations.push_back(original_observation);
+        }
+        std::vector<FixedObservation> merged_observations(
+                observations.size() + fixed_observations.size());
+        std::merge(
+                observations.begin(), observations.end(),
+                fixed_observations.begin(), fixed_observations.end(),
+                merged_observations.begin(),
+                [](
+                    const FixedObservation& observation_1,
+                    const FixedObservation& observation_2)
+                {
+                    return observation_1.start_time < observation_2.start_time;
+                });
+        file << merged_observations.size() << std::endl;
+        for (const FixedObservation& observation: merged_observations)
+            file << observation.original_observable_id
+                << " " << observation.original_target_id
                 << " " << observation.start_time
-                << " " << observation.start_time + instance().observable(night_id, observation.observable_id).observation_time
-                << std::endl;;
+                << " " << observation.end_time
+                << std::endl;
     }
 }
@@ -0,0 +1,178 @@
+#include "starobservationschedulingsolver/flexible_single_night_star_observation_scheduling/algorithms/dynamic_programming.hpp"
+
+#include "starobservationschedulingsolver/flexible_single_night_star_observation_scheduling/instance_builder.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace starobservationschedulingsolver::flexible_single_night_star_observation_scheduling;
+using starobservationschedulingsolver::ObservationTimeReduction;
+
+namespace
+{
+
+struct RandomObservationTimeInterval
+{
+    Time minimum_observation_time;
+    Time maximum_observation_time;
+    Profit profit;
+    Profit profit_slope;
+};
+
+struct RandomTarget
+{
+    Time release_date;
+    Time meridian;
+    Time deadline;
+    std::vector<std::pair<Time, Profit>> observation_times;
+    std::vector<RandomObservationTimeInterval> observation_time_intervals;
+};
+
+/**
+ * Generate the targets of a random night.
+ *
+ * The profits of the observation times are drawn in
+ * '[minimum_profit, 10]'.
+ */
+std::vector<RandomTarget> random_targets(
+        std::mt19937_64& generator,
+        int minimum_profit)
+{
+    std::vector<RandomTarget> targets;
+    TargetId number_of_targets = std::uniform_int_distribution<TargetId>(0, 8)(generator);
+    for (TargetId target_id = 0; target_id < number_of_targets; ++target_id) {
+        RandomTarget target;
+        target.release_date = std::uniform_int_distribution<Time>(0, 30)(generator);
+        target.meridian = target.release_date + std::uniform_int_distribution<Time>(0, 20)(generator);
+        target.deadline = target.meridian + std::uniform_int_distribution<Time>(0, 20)(generator);
+        int number_of_observation_times = std::uniform_int_distribution<int>(0, 6)(generator);
+        for (int pos = 0; pos < number_of_observation_times; ++pos) {
+            target.observation_times.push_back({
+                    std::uniform_int_distribution<Time>(1, 12)(generator),
+                    std::uniform_int_distribution<int>(minimum_profit, 10)(generator)});
+        }
+        int number_of_observation_time_intervals = std::uniform_int_distribution<int>(0, 2)(generator);
+        for (int pos = 0; pos < number_of_observation_time_intervals; ++pos) {
+            RandomObservationTimeInterval interval;
+            interval.minimum_observation_time = std::uniform_int_distribution<Time>(1, 8)(generator);
+            interval.maximum_observation_time = interval.minimum_observation_time
+                + std::uniform_int_distribution<Time>(0, 8)(generator);
+            interval.profit = std::uniform_int_distribution<int>(1, 5)(generator);
+            interval.profit_slope = std::uniform_int_distribution<int>(0, 2)(generator);
+            target.observation_time_intervals.push_back(interval);
+        }
+        targets.push_back(target);
+    }
+    return targets;
+}
+
+/**
+ * Build the instance of a random night.
+ *
+ * If 'expand' is 'true', each observation time interval is added as one
+ * observation time per time unit.
+ */
+Instance build_instance(
+        const std::vector<RandomTarget>& targets,
+        bool expand,
+        ObservationTimeReduction observation_time_reduction = ObservationTimeReduction::None)
+{
+    InstanceBuilder instance_builder;
+    instance_builder.set_observation_time_reduction(observation_time_reduction);
+    for (const RandomTarget& target: targets) {
+        TargetId target_id = instance_builder.add_target(
+                target.release_date,
+                target.meridian,
+                target.deadline);
+        for (const auto& observation_time: target.observation_times) {
+            instance_builder.add_observation_time(
+                    target_id,
+                    observation_time.first,
+                    observation_time.second);
+        }
+        for (const RandomObservationTimeInterval& interval: target.observation_time_intervals) {
+            if (!expand) {
+                instance_builder.add_observation_time_interval(
+                        target_id,
+                        interval.minimum_observation_time,
+                        interval.maximum_observation_time,
+                        interval.profit,
+                        interval.profit_slope);
+                continue;
+            }
+            for (Time observation_time = interval.minimum_observation_time;
+                    observation_time <= interval.maximum_observation_time;
+                    ++observation_time) {
+                instance_builder.add_observation_time(
+                        target_id,
+                        observation_time,
+                        interval.profit + interval.profit_slope
+                        * (observation_time - interval.minimum_observation_time));
+            }
+        }
+    }
+    return instance_builder.build();
+}
+
+Output solve(
+        const Instance& instance,
+        DynamicProgrammingEngine engine)
+{
+    DynamicProgrammingOptionalParameters parameters;
+    parameters.verbosity_level = 0;
+    parameters.engine = engine;
+    return dynamic_programming(instance, parameters);
+}
+
+}
+
+TEST(FlexibleSingleNightStarObservationSchedulingDynamicProgramming, IntervalExpansion)
+{
+    std::mt19937_64 generator(0);
+    for (int test = 0; test < 300; ++test) {
+        std::vector<RandomTarget> targets = random_targets(generator, 1);
+        Instance instance = build_instance(targets, false);
+        Instance expanded_instance = build_instance(targets, true);
+
+        // Reference: the observation times of the expansion are explicit.
+        Output reference_output = solve(expanded_instance, DynamicProgrammingEngine::Pareto);
+        for (DynamicProgrammingEngine engine: {
+                DynamicProgrammingEngine::Pareto,
+                DynamicProgrammingEngine::TimeIndexed}) {
+            Output output = solve(instance, engine);
+            EXPECT_TRUE(output.solution.feasible());
+            EXPECT_DOUBLE_EQ(output.solution.profit(), reference_output.solution.profit());
+            EXPECT_DOUBLE_EQ(output.bound, reference_output.solution.profit());
+
+            Output expanded_output = solve(expanded_instance, engine);
+            EXPECT_DOUBLE_EQ(expanded_output.solution.profit(), reference_output.solution.profit());
+        }
+    }
+}
+
+TEST(FlexibleSingleNightStarObservationSchedulingDynamicProgramming, DominanceReduction)
+{
+    std::mt19937_64 generator(0);
+    Counter number_of_removed_observation_times = 0;
+    for (int test = 0; test < 1000; ++test) {
+        // Some observation times have a non-positive profit.
+        std::vector<RandomTarget> targets = random_targets(generator, -3);
+        Instance instance = build_instance(targets, false);
+        Instance reduced_instance = build_instance(
+                targets,
+                false,
+                ObservationTimeReduction::Dominance);
+        number_of_removed_observation_times += reduced_instance.number_of_removed_observation_times();
+
+        Output reference_output = solve(instance, DynamicProgrammingEngine::Pareto);
+        for (DynamicProgrammingEngine engine: {
+                DynamicProgrammingEngine::Pareto,
+                DynamicProgrammingEngine::TimeIndexed}) {
+            Output output = solve(reduced_instance, engine);
+            EXPECT_TRUE(output.solution.feasible());
+            EXPECT_DOUBLE_EQ(output.solution.profit(), reference_output.solution.profit());
+        }
+    }
+    EXPECT_GT(number_of_removed_observation_times, 0);
+}
@@ -0,0 +1,408 @@
+#include "starobservationschedulingsolver/single_night_star_observation_scheduling/algorithms/dynamic_programming.hpp"
+
+#include "starobservationschedulingsolver/single_night_star_observation_scheduling/instance_builder.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <numeric>
+#include <algorithm>
+
+using namespace starobservationschedulingsolver::single_night_star_observation_scheduling;
+
+namespace
+{
+
+/** Return 'true' iff the observations form a feasible schedule. */
+bool feasible(
+        const DynamicProgrammingSolver& solver,
+        const std::vector<Target>& targets)
+{
+    Time time = 0;
+    for (const Observation& observation: solver.observations()) {
+        const Target& target = targets[observation.target_id];
+        if (observation.start_time < time
+                || observation.start_time < target.release_date
+                || observation.start_time + target.observation_time > target.deadline) {
+            return false;
+        }
+        time = observation.start_time + target.observation_time;
+    }
+    return true;
+}
+
+/**
+ * Generate the targets of a random night.
+ *
+ * The profits are drawn between 'minimum_profit' and 'maximum_profit'. The
+ * time window of a target is longer than its observation time by a slack
+ * drawn between 'minimum_window_slack' and 'maximum_window_slack' times its
+ * observation time; a negative slack gives a time window shorter than the
+ * observation time.
+ */
+std::vector<Target> random_targets(
+        std::mt19937_64& generator,
+        int minimum_profit,
+        int maximum_profit,
+        Time minimum_window_slack,
+        Time maximum_window_slack)
+{
+    TargetId number_of_targets = std::uniform_int_distribution<TargetId>(0, 12)(generator);
+    Time horizon = std::uniform_int_distribution<Time>(5, 60)(generator);
+    std::vector<Target> targets;
+    for (TargetId target_id = 0;
+            target_id < number_of_targets;
+            ++target_id) {
+        Target target;
+        target.observation_time = std::uniform_int_distribution<Time>(1, horizon / 4 + 1)(generator);
+        target.release_date = std::uniform_int_distribution<Time>(0, horizon)(generator);
+        target.deadline = target.release_date + target.observation_time
+            + std::uniform_int_distribution<Time>(
+                    minimum_window_slack * target.observation_time,
+                    maximum_window_slack * target.observation_time)(generator);
+        target.meridian = (target.release_date + target.deadline) / 2;
+        target.profit = std::uniform_int_distribution<int>(minimum_profit, maximum_profit)(generator);
+        targets.push_back(target);
+    }
+    return targets;
+}
+
+/** Add targets to a solver. */
+void add_targets(
+        DynamicProgrammingSolver& solver,
+        const std::vector<Target>& targets)
+{
+    for (const Target& target: targets) {
+        solver.add_target(
+                target.release_date,
+                target.meridian,
+                target.deadline,
+                target.observation_time,
+                target.profit);
+    }
+}
+
+/** Return the profit of the observations of a solver. */
+Profit observations_profit(
+        const DynamicProgrammingSolver& solver,
+        const std::vector<Target>& targets)
+{
+    Profit profit = 0;
+    for (const Observation& observation: solver.observations())
+        profit += targets[observation.target_id].profit;
+    return profit;
+}
+
+/**
+ * Return the optimal profit of a night, computed by the exact Pareto engine
+ * keeping all its stages.
+ */
+Profit optimal_profit(
+        const std::vector<Target>& targets)
+{
+    DynamicProgrammingSolver solver;
+    solver.set_engine(DynamicProgrammingEngine::Pareto);
+    solver.set_storage(DynamicProgrammingStorage::AllStages);
+    add_targets(solver, targets);
+    return solver.solve();
+}
+
+}
+
+TEST(SingleNightStarObservationSchedulingDynamicProgramming, UnicostTimeWindowTooShort)
+{
+    DynamicProgrammingSolver solver;
+    solver.set_engine(DynamicProgrammingEngine::Unicost);
+    solver.add_target(10, 12, 15, 10, 1);
+    solver.add_target(20, 25, 30, 5, 1);
+    EXPECT_EQ(solver.solve(), 1);
+    ASSERT_EQ(solver.observations().size(), (std::size_t)1);
+    EXPECT_EQ(solver.observations()[0].target_id, 1);
+    EXPECT_EQ(solver.observations()[0].start_time, 20);
+}
+
+TEST(SingleNightStarObservationSchedulingDynamicProgramming, UnicostInstance)
+{
+    InstanceBuilder instance_builder;
+    instance_builder.add_target(10, 12, 15, 10, 1);
+    instance_builder.add_target(20, 25, 30, 5, 1);
+    Instance instance = instance_builder.build();
+
+    DynamicProgrammingOptionalParameters parameters;
+    parameters.verbosity_level = 0;
+    // The 'Auto' engine selects the 'Unicost' engine. Building the solution
+    // throws if a target is observed outside of its time window.
+    parameters.engine = DynamicProgrammingEngine::Auto;
+    Profit profit = 0;
+    EXPECT_NO_THROW(profit = dynamic_programming(instance, parameters).solution.profit());
+    EXPECT_EQ(profit, 1);
+}
+
+TEST(SingleNightStarObservationSchedulingDynamicProgramming, UnicostPareto)
+{
+    std::mt19937_64 generator(0);
+    for (int test = 0; test < 1000; ++test) {
+        // Some time windows are shorter than the observation time.
+        std::vector<Target> targets = random_targets(generator, 1, 1, -1, 1);
+        DynamicProgrammingSolver unicost_solver;
+        DynamicProgrammingSolver pareto_solver;
+        unicost_solver.set_engine(DynamicProgrammingEngine::Unicost);
+        pareto_solver.set_engine(DynamicProgrammingEngine::Pareto);
+        add_targets(unicost_solver, targets);
+        add_targets(pareto_solver, targets);
+        EXPECT_EQ(unicost_solver.solve(), pareto_solver.solve());
+        EXPECT_TRUE(feasible(unicost_solver, targets));
+    }
+}
+
+TEST(SingleNightStarObservationSchedulingDynamicProgramming, SetProfit)
+{
+    std::mt19937_64 generator(0);
+    for (DynamicProgrammingEngine engine: {
+            DynamicProgrammingEngine::Auto,
+            DynamicProgrammingEngine::Pareto,
+            DynamicProgrammingEngine::TimeIndexed}) {
+        for (int test = 0; test < 300; ++test) {
+            std::vector<Target> targets = random_targets(generator, -2, 10, 0, 1);
+            if (targets.empty())
+                continue;
+            TargetId number_of_targets = targets.size();
+            DynamicProgrammingSolver solver;
+            solver.set_engine(engine);
+            add_targets(solver, targets);
+            solver.solve();
+
+            // Change the profit of the target in the middle of the meridian
+            // order, so that only the stages after it are recomputed.
+            std::vector<TargetId> sorted_target_ids(number_of_targets);
+            std::iota(sorted_target_ids.begin(), sorted_target_ids.end(), 0);
+            std::stable_sort(
+                    sorted_target_ids.begin(),
+                    sorted_target_ids.end(),
+                    [&targets](TargetId target_id_1, TargetId target_id_2)
+                    {
+                        return targets[target_id_1].meridian
+                            < targets[target_id_2].meridian;
+                    });
+            TargetId target_id = sorted_target_ids[number_of_targets / 2];
+            targets[target_id].profit = std::uniform_int_distribution<int>(-2, 10)(generator);
+            solver.set_profit(target_id, targets[target_id].profit);
+            Profit profit = solver.solve();
+
+            DynamicProgrammingSolver fresh_solver;
+            fresh_solver.set_engine(engine);
+            add_targets(fresh_solver, targets);
+            EXPECT_EQ(profit, fresh_solver.solve());
+            EXPECT_TRUE(feasible(solver, targets));
+            EXPECT_EQ(observations_profit(solver, targets), profit);
+        }
+    }
+}
+
+TEST(SingleNightStarObservationSchedulingDynamicProgramming, SetProfitUnchanged)
+{
+    DynamicProgrammingSolver solver;
+    solver.add_target(0, 5, 10, 8, 3);
+    solver.add_target(5, 10, 15, 8, 2);
+    solver.add_target(10, 15, 20, 8, 4);
+    EXPECT_EQ(solver.solve(), 7);
+    std::vector<Observation> observations = solver.observations();
+
+    // Setting the current profit of a target doesn't change the solution.
+    solver.set_profit(1, 2);
+    EXPECT_EQ(solver.solve(), 7);
+    ASSERT_EQ(solver.observations().size(), observations.size());
+    for (std::size_t pos = 0; pos < observations.size(); ++pos) {
+        EXPECT_EQ(solver.observations()[pos].target_id, observations[pos].target_id);
+        EXPECT_EQ(solver.observations()[pos].start_time, observations[pos].start_time);
+    }
+
+    solver.set_profit(1, 8);
+    EXPECT_EQ(solver.solve(), 8);
+    solver.set_profit(1, 2);
+    EXPECT_EQ(solver.solve(), 7);
+}
+
+TEST(SingleNightStarObservationSchedulingDynamicProgramming, Storage)
+{
+    std::mt19937_64 generator(0);
+    for (int test = 0; test < 300; ++test) {
+        std::vector<Target> targets = random_targets(generator, -2, 10, -1, 1);
+        Profit profit = optimal_profit(targets);
+        for (DynamicProgrammingStorage storage: {
+                DynamicProgrammingStorage::ValueOnly,
+                DynamicProgrammingStorage::Checkpoints}) {
+            DynamicProgrammingSolver solver;
+            solver.set_engine(DynamicProgrammingEngine::Pareto);
+            solver.set_storage(storage);
+            add_targets(solver, targets);
+            EXPECT_EQ(solver.solve(), profit);
+            if (storage == DynamicProgrammingStorage::ValueOnly) {
+                EXPECT_TRUE(solver.observations().empty());
+            } else {
+                EXPECT_TRUE(feasible(solver, targets));
+                EXPECT_EQ(observations_profit(solver, targets), profit);
+            }
+        }
+    }
+}
+
+TEST(SingleNightStarObservationSchedulingDynamicProgramming, Threshold)
+{
+    std::mt19937_64 generator(0);
+    for (DynamicProgrammingEngine engine: {
+            DynamicProgrammingEngine::Auto,
+            DynamicProgrammingEngine::Pareto,
+            DynamicProgrammingEngine::TimeIndexed}) {
+        for (int test = 0; test < 300; ++test) {
+            std::vector<Target> targets = random_targets(generator, -2, 10, -1, 1);
+            Profit optimal = optimal_profit(targets);
+            Profit threshold = optimal + std::uniform_int_distribution<int>(-5, 5)(generator);
+            DynamicProgrammingSolver solver;
+            solver.set_engine(engine);
+            solver.set_threshold(threshold);
+            add_targets(solver, targets);
+            Profit profit = solver.solve();
+            if (solver.stopped_early()) {
+                // Stopping early proves that no schedule has a profit greater
+                // than the threshold.
+                EXPECT_LE(optimal, threshold);
+                EXPECT_EQ(profit, 0);
+                EXPECT_TRUE(solver.observations().empty());
+                EXPECT_EQ(solver.bound(), threshold);
+            } else {
+                // A schedule above the threshold is never lost.
+                EXPECT_EQ(profit, optimal);
+                EXPECT_TRUE(feasible(solver, targets));
+                EXPECT_EQ(observations_profit(solver, targets), profit);
+            }
+        }
+    }
+}
+
+TEST(SingleNightStarObservationSchedulingDynamicProgramming, Epsilon)
+{
+    std::mt19937_64 generator(0);
+    for (int test = 0; test < 300; ++test) {
+        std::vector<Target> targets = random_targets(generator, -2, 10, -1, 1);
+        Profit optimal = optimal_profit(targets);
+        for (double epsilon: {0.1, 0.5}) {
+            DynamicProgrammingSolver solver;
+            solver.set_engine(DynamicProgrammingEngine::Pareto);
+            solver.set_epsilon(epsilon);
+            add_targets(solver, targets);
+            Profit profit = solver.solve();
+            EXPECT_GE(solver.guarantee(), 1 - epsilon);
+            EXPECT_GE(profit, (1 - epsilon) * optimal - 1e-9);
+            EXPECT_LE(profit, optimal);
+            EXPECT_GE(solver.bound(), optimal - 1e-9);
+            EXPECT_TRUE(feasible(solver, targets));
+            EXPECT_EQ(observations_profit(solver, targets), profit);
+        }
+    }
+}
+
+TEST(SingleNightStarObservationSchedulingDynamicProgramming, MaximumNumberOfStates)
+{
+    std::mt19937_64 generator(0);
+    for (int test = 0; test < 300; ++test) {
+        std::vector<Target> targets = random_targets(generator, -2, 10, -1, 1);
+        Profit optimal = optimal_profit(targets);
+        for (Counter maximum_number_of_states: {3, 10, 30}) {
+            for (DynamicProgrammingStorage storage: {
+                    DynamicProgrammingStorage::AllStages,
+                    DynamicProgrammingStorage::Checkpoints}) {
+                DynamicProgrammingSolver solver;
+                solver.set_engine(DynamicProgrammingEngine::Pareto);
+                solver.set_storage(storage);
+                solver.set_maximum_number_of_states(maximum_number_of_states);
+                add_targets(solver, targets);
+                Profit profit = solver.solve();
+                EXPECT_GT(solver.guarantee(), 0);
+                EXPECT_LE(solver.guarantee(), 1);
+                EXPECT_GE(profit, solver.guarantee() * optimal - 1e-9);
+                EXPECT_LE(profit, optimal);
+                EXPECT_GE(solver.bound(), optimal - 1e-9);
+                EXPECT_TRUE(feasible(solver, targets));
+                EXPECT_EQ(observations_profit(solver, targets), profit);
+            }
+        }
+    }
+}
+
+TEST(SingleNightStarObservationSchedulingDynamicProgramming, IntervalScheduling)
+{
+    std::mt19937_64 generator(0);
+    for (DynamicProgrammingEngine engine: {
+            DynamicProgrammingEngine::Auto,
+            DynamicProgrammingEngine::IntervalScheduling}) {
+        for (int test = 0; test < 300; ++test) {
+            // All time windows are rigid; some are shorter than the
+            // observation time.
+            std::vector<Target> targets = random_targets(generator, -2, 10, -1, 0);
+            DynamicProgrammingSolver solver;
+            solver.set_engine(engine);
+            add_targets(solver, targets);
+            Profit profit = solver.solve();
+            EXPECT_EQ(profit, optimal_profit(targets));
+            EXPECT_TRUE(feasible(solver, targets));
+            EXPECT_EQ(observations_profit(solver, targets), profit);
+
+            // Solve again after a profit change.
+            if (targets.empty())
+                continue;
+            TargetId target_id = std::uniform_int_distribution<TargetId>(0, targets.size() - 1)(generator);
+            targets[target_id].profit = std::uniform_int_distribution<int>(-2, 10)(generator);
+            solver.set_profit(target_id, targets[target_id].profit);
+            profit = solver.solve();
+            EXPECT_EQ(profit, optimal_profit(targets));
+            EXPECT_TRUE(feasible(solver, targets));
+            EXPECT_EQ(observations_profit(solver, targets), profit);
+        }
+    }
+}
+
+TEST(SingleNightStarObservationSchedulingDynamicProgramming, Segmentation)
+{
+    std::mt19937_64 generator(0);
+    for (int test = 0; test < 300; ++test) {
+        // The bound of an output starts from the total profit of the
+        // instance, so the profits of the instance are positive.
+        std::vector<Target> targets = random_targets(generator, 1, 10, -1, 1);
+        Profit optimal = optimal_profit(targets);
+        InstanceBuilder instance_builder;
+        for (const Target& target: targets) {
+            instance_builder.add_target(
+                    target.release_date,
+                    target.meridian,
+                    target.deadline,
+                    target.observation_time,
+                    target.profit);
+        }
+        Instance instance = instance_builder.build();
+        Profit threshold = optimal + std::uniform_int_distribution<int>(-5, 5)(generator);
+        for (bool use_threshold: {false, true}) {
+            for (Counter number_of_threads: {1, 3}) {
+                DynamicProgrammingOptionalParameters parameters;
+                parameters.verbosity_level = 0;
+                parameters.segmentation = true;
+                parameters.number_of_threads = number_of_threads;
+                if (use_threshold)
+                    parameters.threshold = threshold;
+                // Building the solution throws if the observations are not
+                // feasible.
+                DynamicProgrammingOutput output(instance);
+                EXPECT_NO_THROW(output = dynamic_programming(instance, parameters));
+                EXPECT_GE(output.bound, optimal);
+                if (!use_threshold || optimal > threshold) {
+                    EXPECT_EQ(output.solution.profit(), optimal);
+                } else if (output.solution.profit() != optimal) {
+                    // The segments proved that no schedule has a profit
+                    // greater than the threshold.
+                    EXPECT_EQ(output.solution.number_of_observations(), 0);
+                    EXPECT_LE(output.bound, threshold);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,91 @@
+#include "starobservationschedulingsolver/star_observation_scheduling/algorithms/column_generation.hpp"
+
+#include "starobservationschedulingsolver/star_observation_scheduling/instance_builder.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace starobservationschedulingsolver::star_observation_scheduling;
+
+namespace
+{
+
+/**
+ * Generate a random instance made of several connected components: the
+ * nights and the targets are split into groups, and each observable
+ * connects a night and a target of the same group.
+ */
+Instance random_instance(
+        std::mt19937_64& generator,
+        NightId number_of_components)
+{
+    NightId number_of_nights_per_component = std::uniform_int_distribution<NightId>(1, 3)(generator);
+    TargetId number_of_targets_per_component = std::uniform_int_distribution<TargetId>(2, 8)(generator);
+    InstanceBuilder instance_builder;
+    instance_builder.set_number_of_nights(number_of_components * number_of_nights_per_component);
+    instance_builder.set_number_of_targets(number_of_components * number_of_targets_per_component);
+    for (NightId component_id = 0;
+            component_id < number_of_components;
+            ++component_id) {
+        for (TargetId target_pos = 0;
+                target_pos < number_of_targets_per_component;
+                ++target_pos) {
+            TargetId target_id = component_id * number_of_targets_per_component + target_pos;
+            instance_builder.set_profit(
+                    target_id,
+                    std::uniform_int_distribution<int>(1, 10)(generator));
+            for (NightId night_pos = 0;
+                    night_pos < number_of_nights_per_component;
+                    ++night_pos) {
+                if (night_pos > 0 && std::uniform_int_distribution<int>(0, 1)(generator) == 0)
+                    continue;
+                NightId night_id = component_id * number_of_nights_per_component + night_pos;
+                Time observation_time = std::uniform_int_distribution<Time>(1, 10)(generator);
+                Time release_date = std::uniform_int_distribution<Time>(0, 30)(generator);
+                Time deadline = release_date + observation_time
+                    + std::uniform_int_distribution<Time>(0, 10)(generator);
+                Time meridian = (release_date + deadline) / 2;
+                instance_builder.add_observable(
+                        night_id,
+                        target_id,
+                        release_date,
+                        meridian,
+                        deadline,
+                        observation_time);
+            }
+        }
+    }
+    return instance_builder.build();
+}
+
+}
+
+TEST(StarObservationSchedulingColumnGeneration, Decomposition)
+{
+    std::mt19937_64 generator(0);
+    for (int test = 0; test < 50; ++test) {
+        NightId number_of_components = std::uniform_int_distribution<NightId>(2, 4)(generator);
+        Instance instance = random_instance(generator, number_of_components);
+
+        ColumnGenerationOptionalParameters parameters;
+        parameters.verbosity_level = 0;
+        parameters.number_of_threads = 1 + test % 3;
+        Output output = column_generation_greedy(instance, parameters);
+
+        ColumnGenerationOptionalParameters unsplit_parameters = parameters;
+        unsplit_parameters.decomposition = false;
+        Output unsplit_output = column_generation_greedy(instance, unsplit_parameters);
+
+        // The linear relaxation decomposes, so the merged bound is the bound
+        // of the whole instance, up to the rounding of each component.
+        EXPECT_GE(output.bound, unsplit_output.bound);
+        EXPECT_LT(output.bound, unsplit_output.bound + (Profit)instance.number_of_components());
+
+        // The merged solution is a solution of the whole instance.
+        EXPECT_TRUE(output.solution.feasible());
+        EXPECT_GE(output.bound, output.solution.profit());
+        EXPECT_GE(output.bound, unsplit_output.solution.profit());
+        EXPECT_GE(unsplit_output.bound, output.solution.profit());
+    }
+}
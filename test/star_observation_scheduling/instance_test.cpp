@@ -0,0 +1,78 @@
+#include "starobservationschedulingsolver/star_observation_scheduling/instance_builder.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace starobservationschedulingsolver::star_observation_scheduling;
+
+namespace
+{
+
+Instance build_instance(bool night_observables)
+{
+    InstanceBuilder instance_builder;
+    instance_builder.set_number_of_nights(3);
+    instance_builder.set_number_of_targets(3);
+    // Night 0.
+    instance_builder.add_observable(0, 2, 0, 10, 20, 5);  // observable 0
+    instance_builder.add_observable(0, 0, 5, 15, 25, 5);  // observable 1
+    // Night 1: target 1 has several observables.
+    instance_builder.add_observable(1, 1, 20, 30, 40, 5);  // observable 0
+    instance_builder.add_observable(1, 0, 0, 10, 20, 5);  // observable 1
+    instance_builder.add_observable(1, 1, 0, 5, 10, 5);  // observable 2
+    // Night 2.
+    instance_builder.add_observable(2, 1, 0, 10, 20, 5);  // observable 0
+    instance_builder.set_unicost();
+    instance_builder.set_night_observables(night_observables);
+    return instance_builder.build();
+}
+
+}
+
+TEST(StarObservationSchedulingInstance, ObservableId)
+{
+    Instance instance = build_instance(false);
+
+    EXPECT_EQ(instance.observable_id(0, 0), 1);
+    EXPECT_EQ(instance.observable_id(1, 0), 1);
+    EXPECT_EQ(instance.observable_id(2, 0), -1);
+
+    EXPECT_EQ(instance.observable_id(0, 1), -1);
+    EXPECT_EQ(instance.observable_id(1, 1), 0);
+    EXPECT_EQ(instance.observable_id(2, 1), 0);
+
+    EXPECT_EQ(instance.observable_id(0, 2), 0);
+    EXPECT_EQ(instance.observable_id(1, 2), -1);
+    EXPECT_EQ(instance.observable_id(2, 2), -1);
+
+    // Every observable of the target is listed, sorted by night.
+    std::vector<std::pair<NightId, ObservableId>> observables;
+    for (const auto& observable: instance.observables(1))
+        observables.push_back(observable);
+    std::vector<std::pair<NightId, ObservableId>> expected_observables
+        = {{1, 0}, {1, 2}, {2, 0}};
+    EXPECT_EQ(observables, expected_observables);
+}
+
+TEST(StarObservationSchedulingInstance, NightObservables)
+{
+    EXPECT_FALSE(build_instance(false).has_night_observables());
+
+    Instance instance = build_instance(true);
+    ASSERT_TRUE(instance.has_night_observables());
+    for (NightId night_id = 0;
+            night_id < instance.number_of_nights();
+            ++night_id) {
+        const NightObservables& night_observables = instance.night_observables(night_id);
+        NightObservables expected_night_observables = instance.compute_night_observables(night_id);
+        EXPECT_EQ(night_observables.observable_ids, expected_night_observables.observable_ids);
+        EXPECT_EQ(night_observables.target_ids, expected_night_observables.target_ids);
+        EXPECT_EQ(night_observables.meridians, expected_night_observables.meridians);
+    }
+
+    // The observables are sorted by meridian.
+    const NightObservables& night_observables = instance.night_observables(1);
+    std::vector<ObservableId> expected_observable_ids = {2, 1, 0};
+    EXPECT_EQ(night_observables.observable_ids, expected_observable_ids);
+    std::vector<TargetId> expected_target_ids = {1, 0, 1};
+    EXPECT_EQ(night_observables.target_ids, expected_target_ids);
+}
@@ -0,0 +1,83 @@
+#include "starobservationschedulingsolver/star_observation_scheduling/solution.hpp"
+
+#include "starobservationschedulingsolver/star_observation_scheduling/instance_builder.hpp"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+
+using namespace starobservationschedulingsolver::star_observation_scheduling;
+
+TEST(StarObservationSchedulingSolution, WriteReducedInstance)
+{
+    InstanceBuilder instance_builder;
+    instance_builder.set_number_of_nights(2);
+    instance_builder.set_number_of_targets(6);
+    // Night 0.
+    instance_builder.add_observable(0, 0, 0, 5, 10, 5);  // dominated by 1
+    instance_builder.add_observable(0, 0, 0, 10, 20, 5);
+    instance_builder.add_observable(0, 1, 10, 15, 20, 5);
+    instance_builder.add_observable(0, 2, 30, 35, 40, 5);  // fixed
+    instance_builder.add_observable(0, 3, 0, 5, 10, 5);  // unprofitable
+    // Night 1.
+    instance_builder.add_observable(1, 1, 0, 2, 4, 5);  // infeasible
+    instance_builder.add_observable(1, 4, 0, 5, 10, 6);
+    instance_builder.add_observable(1, 5, 0, 5, 10, 6);
+    instance_builder.add_observable(1, 2, 0, 5, 10, 5);  // target fixed
+    instance_builder.add_observable(1, 5, 0, 5, 10, 6);  // identical to 2
+    instance_builder.set_profit(0, 3);
+    instance_builder.set_profit(1, 4);
+    instance_builder.set_profit(2, 5);
+    instance_builder.set_profit(3, 0);
+    instance_builder.set_profit(4, 2);
+    instance_builder.set_profit(5, 1);
+    instance_builder.set_reduction(true);
+    Instance instance = instance_builder.build();
+
+    ASSERT_TRUE(instance.reduced());
+    EXPECT_EQ(instance.number_of_infeasible_observables(), 1);
+    EXPECT_EQ(instance.number_of_unprofitable_targets(), 1);
+    EXPECT_EQ(instance.number_of_dominated_observables(), 2);
+    EXPECT_EQ(instance.number_of_observables_of_fixed_targets(), 1);
+    EXPECT_EQ(instance.number_of_fixed_targets(), 1);
+    EXPECT_EQ(instance.fixed_profit(), 5);
+
+    ASSERT_EQ(instance.number_of_targets(), 4);
+    EXPECT_EQ(instance.original_target_id(0), 0);
+    EXPECT_EQ(instance.original_target_id(1), 1);
+    EXPECT_EQ(instance.original_target_id(2), 4);
+    EXPECT_EQ(instance.original_target_id(3), 5);
+    ASSERT_EQ(instance.night(0).observables.size(), (size_t)2);
+    EXPECT_EQ(instance.original_observable_id(0, 0), 1);
+    EXPECT_EQ(instance.original_observable_id(0, 1), 2);
+    ASSERT_EQ(instance.night(1).observables.size(), (size_t)2);
+    EXPECT_EQ(instance.original_observable_id(1, 0), 1);
+    EXPECT_EQ(instance.original_observable_id(1, 1), 2);
+
+    Solution solution(instance);
+    EXPECT_EQ(solution.profit(), 5);
+    EXPECT_EQ(solution.number_of_observations(), 1);
+    solution.append_observation(0, 0, 0);
+    solution.append_observation(0, 1, 10);
+    solution.append_observation(1, 1, 0);
+    EXPECT_EQ(solution.profit(), 13);
+    EXPECT_EQ(solution.number_of_observations(), 4);
+
+    // The certificate uses the original ids and includes the fixed
+    // observation.
+    std::string certificate_path = testing::TempDir() + "sosp_reduced_solution.txt";
+    solution.write(certificate_path);
+    std::ifstream file(certificate_path);
+    std::stringstream certificate;
+    certificate << file.rdbuf();
+    EXPECT_EQ(
+            certificate.str(),
+            "2\n"
+            "3\n"
+            "1 0 0 5\n"
+            "2 1 10 15\n"
+            "3 2 30 35\n"
+            "1\n"
+            "2 5 0 6\n");
+}
@@ -0,0 +1,151 @@
+#include "starobservationschedulingsolver/utils/pareto_front.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace starobservationschedulingsolver;
+
+namespace
+{
+
+/** Generate a random front, sorted by increasing time and profit. */
+ParetoStates random_front(
+        std::mt19937_64& generator)
+{
+    ParetoStates states;
+    int64_t number_of_states = std::uniform_int_distribution<int64_t>(0, 20)(generator);
+    TimeType time = std::uniform_int_distribution<TimeType>(0, 10)(generator);
+    double profit = std::uniform_int_distribution<int>(0, 3)(generator);
+    for (int64_t state_id = 0; state_id < number_of_states; ++state_id) {
+        states.push_back(time, profit, state_id, state_id);
+        time += std::uniform_int_distribution<TimeType>(1, 5)(generator);
+        profit += std::uniform_int_distribution<int>(1, 5)(generator);
+    }
+    return states;
+}
+
+/**
+ * Merge two fronts without any of the tricks of 'merge_fronts': the states
+ * of both fronts are sorted by time and a state is kept if its profit is
+ * greater than the profit of all the states ending at the same time or
+ * earlier.
+ */
+std::vector<std::pair<TimeType, double>> reference_merge(
+        std::vector<std::pair<TimeType, double>> states)
+{
+    std::sort(
+            states.begin(),
+            states.end(),
+            [](
+                const std::pair<TimeType, double>& state_1,
+                const std::pair<TimeType, double>& state_2)
+            {
+                if (state_1.first != state_2.first)
+                    return state_1.first < state_2.first;
+                return state_1.second > state_2.second;
+            });
+    std::vector<std::pair<TimeType, double>> front;
+    for (const auto& state: states) {
+        if (!front.empty() && state.second <= front.back().second)
+            continue;
+        front.push_back(state);
+    }
+    return front;
+}
+
+}
+
+TEST(ParetoFront, MergeFronts)
+{
+    std::mt19937_64 generator(0);
+    for (int test = 0; test < 1000; ++test) {
+        ParetoStates states = random_front(generator);
+        int64_t number_of_states = states.size;
+        TimeType release_date = std::uniform_int_distribution<TimeType>(0, 60)(generator);
+        TimeType observation_time = std::uniform_int_distribution<TimeType>(1, 20)(generator);
+        TimeType deadline = release_date + observation_time
+            + std::uniform_int_distribution<TimeType>(0, 60)(generator);
+        TimeType latest_start = std::uniform_int_distribution<TimeType>(release_date, deadline - observation_time)(generator);
+        double profit = std::uniform_int_distribution<int>(0, 10)(generator);
+        int32_t label = 100;
+
+        // As in the Pareto stages, the extension starts from the last state
+        // ending before the release date, so that the extended times are
+        // increasing.
+        const TimeType* times = states.times.data();
+        int64_t extension_start = std::upper_bound(
+                times,
+                times + number_of_states,
+                release_date) - times;
+        if (extension_start > 0)
+            extension_start--;
+        int64_t extension_end = std::upper_bound(
+                times + extension_start,
+                times + number_of_states,
+                latest_start) - times;
+
+        // Reference extension.
+        std::vector<std::pair<TimeType, double>> reference_states;
+        std::vector<TimeType> reference_extended_times;
+        for (int64_t state_id = 0; state_id < number_of_states; ++state_id)
+            reference_states.push_back({states.times[state_id], states.profits[state_id]});
+        for (int64_t state_id = extension_start; state_id < extension_end; ++state_id) {
+            TimeType end = (std::max)(states.times[state_id], release_date) + observation_time;
+            if (end > deadline)
+                break;
+            reference_extended_times.push_back(end);
+            reference_states.push_back({end, states.profits[state_id] + profit});
+        }
+        std::vector<std::pair<TimeType, double>> reference_front = reference_merge(reference_states);
+
+        std::vector<TimeType> extended_times(number_of_states);
+        int64_t number_of_extended_states = extend_times(
+                times + extension_start,
+                extension_end - extension_start,
+                release_date,
+                observation_time,
+                latest_start,
+                deadline,
+                extended_times.data());
+        ASSERT_EQ(number_of_extended_states, (int64_t)reference_extended_times.size());
+        for (int64_t pos = 0; pos < number_of_extended_states; ++pos)
+            EXPECT_EQ(extended_times[pos], reference_extended_times[pos]);
+
+        // The result is appended to the states, which are also both sources.
+        int64_t start = merge_fronts(
+                states,
+                0,
+                number_of_states,
+                states,
+                extension_start,
+                extended_times.data(),
+                number_of_extended_states,
+                profit,
+                label,
+                states);
+        ASSERT_EQ(start, number_of_states);
+        ASSERT_EQ(states.size - start, (int64_t)reference_front.size());
+        for (int64_t pos = 0; pos < (int64_t)reference_front.size(); ++pos) {
+            int64_t state_id = start + pos;
+            EXPECT_EQ(states.times[state_id], reference_front[pos].first);
+            EXPECT_EQ(states.profits[state_id], reference_front[pos].second);
+
+            // The previous state and the label of a state identify where it
+            // comes from.
+            int32_t prev = states.prevs[state_id];
+            if (states.labels[state_id] == label) {
+                ASSERT_GE(prev, extension_start);
+                ASSERT_LT(prev, extension_start + number_of_extended_states);
+                EXPECT_EQ(states.times[state_id], extended_times[prev - extension_start]);
+                EXPECT_EQ(states.profits[state_id], states.profits[prev] + profit);
+            } else {
+                ASSERT_GE(prev, 0);
+                ASSERT_LT(prev, number_of_states);
+                EXPECT_EQ(states.labels[state_id], prev);
+                EXPECT_EQ(states.times[state_id], states.times[prev]);
+                EXPECT_EQ(states.profits[state_id], states.profits[prev]);
+            }
+        }
+    }
+}